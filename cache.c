@@ -0,0 +1,269 @@
+/**
+ * @file cache.c
+ * @brief Cache des solutions optimales indexé par empreinte d'instance, éviction LRU, sauvegarde sur disque.
+ * Une instance déjà résolue (même n, m, A, P, C, U) est servie sans pivot ; une instance de même
+ * matrice A mais d'offres/demandes différentes repart de la base en cache.
+ */
+
+#include "projet_ro.h"
+#include <pthread.h>
+
+typedef struct {
+    EmpreinteProbleme empreinte;
+    uint64_t utilisation;     // Horodatage logique du dernier accès (LRU)
+    SolutionCreuse* solution; // Copie possédée par le cache (NULL : entrée libre)
+} EntreeCache;
+
+struct CacheSolutions {
+    EntreeCache* entrees;
+    int capacite;
+    uint64_t horloge;          // Incrémentée à chaque accès
+    StatistiquesCache stats;
+    pthread_mutex_t verrou;    // Le cache peut être partagé entre poignées utilisées en parallèle
+};
+
+static const char MAGIC_CACHE[4] = { 'R', 'O', 'C', 'A' };
+
+// ==========================================================
+// 1. EMPREINTES
+// ==========================================================
+
+/**
+ * @brief Mélange un mot dans un état de hachage (multiplication puis rotation).
+ */
+static inline uint64_t melanger(uint64_t h, uint64_t x) {
+    h ^= x * 0x9E3779B97F4A7C15ull;
+    h = (h << 27) | (h >> 37);
+    return h * 0xBF58476D1CE4E5B9ull;
+}
+
+/**
+ * @brief Finalisation (avalanche) d'un état de hachage.
+ */
+static inline uint64_t finaliser(uint64_t h) {
+    h ^= h >> 31;
+    h *= 0x94D049BB133111EBull;
+    return h ^ (h >> 29);
+}
+
+static inline uint64_t motReel(double x) {
+    uint64_t bits;
+    if (x == 0.0) x = 0.0; // -0.0 et 0.0 donnent la même empreinte
+    memcpy(&bits, &x, sizeof(bits));
+    return bits;
+}
+
+EmpreinteProbleme empreinteProbleme(const ProblemeTransport* p) {
+    int n = p->n, m = p->m;
+    // Quatre états indépendants : les multiplications de cases voisines ne s'attendent pas
+    uint64_t h[4] = { 0x243F6A8885A308D3ull, 0x13198A2E03707344ull, 0xA4093822299F31D0ull, 0x082EFA98EC4E6C89ull };
+    for (int i = 0; i < n; i++) {
+        const double* ligne = p->A[i];
+        int j = 0;
+        for (; j + 4 <= m; j += 4) {
+            h[0] = melanger(h[0], motReel(ligne[j]));
+            h[1] = melanger(h[1], motReel(ligne[j + 1]));
+            h[2] = melanger(h[2], motReel(ligne[j + 2]));
+            h[3] = melanger(h[3], motReel(ligne[j + 3]));
+        }
+        for (; j < m; j++) h[j & 3] = melanger(h[j & 3], motReel(ligne[j]));
+    }
+    uint64_t couts = melanger(melanger(0, (uint64_t)n << 32 | (uint32_t)m), h[0]);
+    couts = melanger(melanger(melanger(couts, h[1]), h[2]), h[3]);
+
+    uint64_t probleme = couts;
+    for (int i = 0; i < n; i++) probleme = melanger(probleme, (uint32_t)p->P[i]);
+    for (int j = 0; j < m; j++) probleme = melanger(probleme, (uint64_t)1 << 32 | (uint32_t)p->C[j]);
+    if (p->U) {
+        for (int i = 0; i < n; i++)
+            for (int k = p->U->debut[i]; k < p->U->debut[i + 1]; k++)
+                probleme = melanger(probleme, (uint64_t)i << 40 ^ (uint64_t)p->U->colonne[k] << 20
+                                              ^ (uint32_t)p->U->capacite[k]);
+    }
+
+    EmpreinteProbleme e = { finaliser(probleme), finaliser(couts) };
+    return e;
+}
+
+// ==========================================================
+// 2. CACHE EN MEMOIRE
+// ==========================================================
+
+CacheSolutions* creerCacheSolutions(int capacite) {
+    if (capacite <= 0) return NULL;
+    CacheSolutions* c = (CacheSolutions*)calloc(1, sizeof(CacheSolutions));
+    if (!c) return NULL;
+    c->entrees = (EntreeCache*)calloc(capacite, sizeof(EntreeCache));
+    if (!c->entrees) { free(c); return NULL; }
+    c->capacite = capacite;
+    pthread_mutex_init(&c->verrou, NULL);
+    return c;
+}
+
+void libererCacheSolutions(CacheSolutions* c) {
+    if (!c) return;
+    for (int k = 0; k < c->capacite; k++) libererSolutionCreuse(c->entrees[k].solution);
+    free(c->entrees);
+    pthread_mutex_destroy(&c->verrou);
+    free(c);
+}
+
+ResultatCache chercherCache(CacheSolutions* c, const EmpreinteProbleme* e, SolutionCreuse** copie) {
+    *copie = NULL;
+    pthread_mutex_lock(&c->verrou);
+    // Quelques dizaines d'entrées au plus : un parcours linéaire coûte peu face au hachage en O(n*m)
+    EntreeCache* trouvee = NULL;
+    ResultatCache resultat = CACHE_ABSENT;
+    for (int k = 0; k < c->capacite; k++) {
+        EntreeCache* x = &c->entrees[k];
+        if (!x->solution || x->empreinte.couts != e->couts) continue;
+        if (x->empreinte.probleme == e->probleme) { trouvee = x; resultat = CACHE_EXACT; break; }
+        if (!trouvee || x->utilisation > trouvee->utilisation) { trouvee = x; resultat = CACHE_VOISIN; }
+    }
+    if (trouvee) {
+        trouvee->utilisation = ++c->horloge;
+        *copie = copierSolutionCreuse(trouvee->solution);
+        if (!*copie) resultat = CACHE_ABSENT;
+    }
+    if (resultat == CACHE_EXACT) c->stats.exacts++;
+    else if (resultat == CACHE_VOISIN) c->stats.voisins++;
+    else c->stats.absents++;
+    pthread_mutex_unlock(&c->verrou);
+    return resultat;
+}
+
+/**
+ * @brief Range une solution (possédée ensuite par le cache) : remplace l'entrée de même empreinte,
+ * sinon occupe une entrée libre ou évince la moins récemment utilisée. Verrou tenu.
+ */
+static void rangerSolution(CacheSolutions* c, const EmpreinteProbleme* e, SolutionCreuse* solution) {
+    EntreeCache* cible = NULL;
+    bool meme_instance = false;
+    for (int k = 0; k < c->capacite; k++) {
+        EntreeCache* x = &c->entrees[k];
+        if (x->solution && x->empreinte.probleme == e->probleme && x->empreinte.couts == e->couts) {
+            cible = x;
+            meme_instance = true;
+            break;
+        }
+        if (!x->solution) { if (!cible || cible->solution) cible = x; }
+        else if (!cible || (cible->solution && x->utilisation < cible->utilisation)) cible = x;
+    }
+    if (cible->solution && !meme_instance) c->stats.evictions++;
+    libererSolutionCreuse(cible->solution);
+    cible->empreinte = *e;
+    cible->solution = solution;
+    cible->utilisation = ++c->horloge;
+}
+
+bool ajouterCache(CacheSolutions* c, const EmpreinteProbleme* e, const SolutionCreuse* s) {
+    SolutionCreuse* copie = copierSolutionCreuse(s);
+    if (!copie) return false;
+    pthread_mutex_lock(&c->verrou);
+    rangerSolution(c, e, copie);
+    pthread_mutex_unlock(&c->verrou);
+    return true;
+}
+
+StatistiquesCache statistiquesCache(CacheSolutions* c) {
+    pthread_mutex_lock(&c->verrou);
+    StatistiquesCache stats = c->stats;
+    stats.entrees = 0;
+    for (int k = 0; k < c->capacite; k++) stats.entrees += (c->entrees[k].solution != NULL);
+    pthread_mutex_unlock(&c->verrou);
+    return stats;
+}
+
+// ==========================================================
+// 3. PERSISTANCE
+// ==========================================================
+
+bool sauverCacheSolutions(CacheSolutions* c, const char* nomFichier) {
+    FILE* f = fopen(nomFichier, "wb");
+    if (!f) return false;
+    pthread_mutex_lock(&c->verrou);
+    // Entrées écrites de la plus ancienne à la plus récente : la relecture reproduit l'ordre LRU
+    int32_t nb = 0;
+    for (int k = 0; k < c->capacite; k++) nb += (c->entrees[k].solution != NULL);
+    bool ok = fwrite(MAGIC_CACHE, 1, 4, f) == 4 && fwrite(&nb, sizeof(nb), 1, f) == 1;
+    uint64_t deja = 0;
+    for (int t = 0; ok && t < nb; t++) {
+        const EntreeCache* suivante = NULL;
+        for (int k = 0; k < c->capacite; k++) {
+            const EntreeCache* x = &c->entrees[k];
+            if (x->solution && x->utilisation > deja && (!suivante || x->utilisation < suivante->utilisation))
+                suivante = x;
+        }
+        deja = suivante->utilisation;
+        ok = fwrite(&suivante->empreinte, sizeof(EmpreinteProbleme), 1, f) == 1
+          && ecrireSolutionBinaire(suivante->solution, f);
+    }
+    pthread_mutex_unlock(&c->verrou);
+    return (fclose(f) == 0) && ok;
+}
+
+bool chargerCacheSolutions(CacheSolutions* c, const char* nomFichier) {
+    FILE* f = fopen(nomFichier, "rb");
+    if (!f) return false;
+    char magic[4];
+    int32_t nb;
+    bool ok = fread(magic, 1, 4, f) == 4 && memcmp(magic, MAGIC_CACHE, 4) == 0
+           && fread(&nb, sizeof(nb), 1, f) == 1 && nb >= 0;
+    pthread_mutex_lock(&c->verrou);
+    for (int t = 0; ok && t < nb; t++) {
+        EmpreinteProbleme e;
+        SolutionCreuse* s = NULL;
+        ok = fread(&e, sizeof(e), 1, f) == 1 && (s = lireSolutionBinaireFlux(f)) != NULL;
+        if (ok) rangerSolution(c, &e, s);
+    }
+    pthread_mutex_unlock(&c->verrou);
+    fclose(f);
+    return ok;
+}
+
+// ==========================================================
+// 4. RESOLUTION AVEC CACHE
+// ==========================================================
+
+SolutionCreuse* resoudreAvecCache(ProblemeTransport* p, CacheSolutions* c, MethodeInitiale methode,
+                                  const SolutionCreuse* base_chaude, const OptionsMarchePied* o,
+                                  ResultatCache* origine) {
+    OptionsMarchePied options;
+    if (o) options = *o;
+    else optionsMarchePiedParDefaut(&options);
+    ResultatMarchePied stats_locales;
+    if (!options.resultat) options.resultat = &stats_locales;
+    ResultatMarchePied* stats = options.resultat;
+
+    EmpreinteProbleme e = empreinteProbleme(p);
+    SolutionCreuse* en_cache = NULL;
+    ResultatCache r = chercherCache(c, &e, &en_cache);
+
+    // Même instance : le certificat garantit la solution même en cas de collision d'empreintes
+    if (r == CACHE_EXACT && verifierCertificatOptimalite(p, en_cache, 1e-6, NULL)) {
+        appliquerSolutionCreuse(p, en_cache);
+        memset(stats, 0, sizeof(*stats));
+        stats->optimal = true;
+        stats->cause = ARRET_OPTIMAL;
+        stats->cout_initial = stats->cout_total = en_cache->cout_total;
+        if (origine) *origine = CACHE_EXACT;
+        return en_cache;
+    }
+
+    SolutionCreuse* sol;
+    if (base_chaude && appliquerBaseVoisine(p, base_chaude)) {
+        r = CACHE_ABSENT;
+        sol = algoMarchePiedOptions(p, &options);
+    } else if (en_cache && appliquerBaseVoisine(p, en_cache)) {
+        r = CACHE_VOISIN;
+        sol = algoMarchePiedOptions(p, &options);
+    } else {
+        r = CACHE_ABSENT;
+        sol = resoudreAnytime(p, methode, &options, stats);
+    }
+    libererSolutionCreuse(en_cache);
+
+    if (sol && stats->optimal) ajouterCache(c, &e, sol); // Échec d'allocation : la solution reste valable
+    if (origine) *origine = r;
+    return sol;
+}
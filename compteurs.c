@@ -0,0 +1,131 @@
+/**
+ * @file compteurs.c
+ * @brief Compteurs matériels par phase (perf_event_open, Linux) : cycles, instructions, défauts du
+ * dernier niveau de cache, branchements mal prédits. Les quatre compteurs forment un groupe lu en un
+ * seul appel système ; une phase cumule la différence entre deux lectures, mise à l'échelle quand le
+ * noyau a multiplexé le groupe avec d'autres événements.
+ */
+
+#define _DEFAULT_SOURCE // syscall()
+
+#include "projet_ro.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+struct CompteursMateriels {
+    int fd[NB_COMPTEURS_MATERIELS];                 // fd[0] : meneur du groupe
+    MesureMaterielle cumul[NB_PHASES_MESUREES];     // Totaux par phase depuis la dernière remise à zéro
+};
+
+#ifdef __linux__
+
+// Événements du noyau, dans l'ordre de CompteurMateriel
+static const uint32_t TYPES[NB_COMPTEURS_MATERIELS] = {
+    PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE, PERF_TYPE_HARDWARE
+};
+static const unsigned long long EVENEMENTS[NB_COMPTEURS_MATERIELS] = {
+    PERF_COUNT_HW_CPU_CYCLES,
+    PERF_COUNT_HW_INSTRUCTIONS,
+    // Lectures manquées dans le dernier niveau de cache (PERF_COUNT_HW_CACHE_MISSES n'est pas défini
+    // de la même façon sur tous les processeurs)
+    PERF_COUNT_HW_CACHE_LL | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+    PERF_COUNT_HW_BRANCH_MISSES
+};
+
+CompteursMateriels* ouvrirCompteursMateriels(void) {
+    CompteursMateriels* c = (CompteursMateriels*)calloc(1, sizeof(CompteursMateriels));
+    if (!c) return NULL;
+    for (int k = 0; k < NB_COMPTEURS_MATERIELS; k++) c->fd[k] = -1;
+
+    bool ok = true;
+    for (int k = 0; ok && k < NB_COMPTEURS_MATERIELS; k++) {
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = TYPES[k];
+        attr.config = EVENEMENTS[k];
+        attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        attr.disabled = (k == 0);  // Le groupe démarre d'un bloc quand le meneur est activé
+        attr.exclude_kernel = 1;   // Autorisé avec perf_event_paranoid <= 2
+        attr.exclude_hv = 1;
+        // Thread appelant seulement : les threads du pool ne sont pas comptés
+        c->fd[k] = (int)syscall(SYS_perf_event_open, &attr, 0, -1, (k == 0) ? -1 : c->fd[0], 0);
+        ok = c->fd[k] >= 0;
+    }
+    ok = ok && ioctl(c->fd[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP) == 0;
+    if (!ok) { fermerCompteursMateriels(c); return NULL; }
+    return c;
+}
+
+void fermerCompteursMateriels(CompteursMateriels* c) {
+    if (!c) return;
+    for (int k = NB_COMPTEURS_MATERIELS - 1; k >= 0; k--)
+        if (c->fd[k] >= 0) close(c->fd[k]);
+    free(c);
+}
+
+/**
+ * @brief Valeurs brutes courantes du groupe ({ nr, time_enabled, time_running, valeurs[nr] }).
+ */
+static void lireGroupe(const CompteursMateriels* c, MesureMaterielle* m) {
+    uint64_t tampon[3 + NB_COMPTEURS_MATERIELS];
+    if (read(c->fd[0], tampon, sizeof(tampon)) != (ssize_t)sizeof(tampon) || tampon[0] != NB_COMPTEURS_MATERIELS) {
+        memset(m, 0, sizeof(*m));
+        return;
+    }
+    m->temps_actif = tampon[1];
+    m->temps_compte = tampon[2];
+    memcpy(m->valeurs, tampon + 3, sizeof(m->valeurs));
+}
+
+#else
+
+CompteursMateriels* ouvrirCompteursMateriels(void) {
+    return NULL; // perf_event_open n'existe que sous Linux
+}
+
+void fermerCompteursMateriels(CompteursMateriels* c) {
+    free(c);
+}
+
+static void lireGroupe(const CompteursMateriels* c, MesureMaterielle* m) {
+    (void)c;
+    memset(m, 0, sizeof(*m));
+}
+
+#endif
+
+void debuterPhase(CompteursMateriels* c, MesureMaterielle* depart) {
+    lireGroupe(c, depart);
+}
+
+void terminerPhase(CompteursMateriels* c, PhaseMesuree phase, const MesureMaterielle* depart) {
+    MesureMaterielle fin;
+    lireGroupe(c, &fin);
+    if (fin.temps_actif < depart->temps_actif || fin.temps_compte < depart->temps_compte) return; // Lecture ratée
+    uint64_t actif = fin.temps_actif - depart->temps_actif;
+    uint64_t compte = fin.temps_compte - depart->temps_compte;
+    MesureMaterielle* cumul = &c->cumul[phase];
+    cumul->temps_actif += actif;
+    cumul->temps_compte += compte;
+    // Groupe multiplexé : les événements comptés sur une partie de la phase sont extrapolés à toute la phase
+    // (jamais compté : rien n'est ajouté, l'écart des temps signale la perte)
+    for (int k = 0; compte > 0 && k < NB_COMPTEURS_MATERIELS; k++) {
+        if (fin.valeurs[k] < depart->valeurs[k]) continue;
+        double delta = (double)(fin.valeurs[k] - depart->valeurs[k]);
+        cumul->valeurs[k] += (uint64_t)(actif > compte ? delta * (double)actif / (double)compte : delta);
+    }
+}
+
+void remettreCompteursAZero(CompteursMateriels* c) {
+    memset(c->cumul, 0, sizeof(c->cumul));
+}
+
+const MesureMaterielle* cumulPhase(const CompteursMateriels* c, PhaseMesuree phase) {
+    return &c->cumul[phase];
+}
@@ -0,0 +1,543 @@
+/**
+ * @file demon.c
+ * @brief Démon de résolution sur socket Unix : instances et pool de threads résidents, protocole binaire
+ * (voir section 13 de projet_ro.h). Contient aussi les fonctions client utilisées par `--client`.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include "projet_ro.h"
+#include <errno.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// ==========================================================
+// 1. ENTREES / SORTIES
+// ==========================================================
+
+/**
+ * @brief Lit exactement taille octets. @return false si la connexion est fermée ou en erreur.
+ */
+static bool lireTout(int fd, void* destination, size_t taille) {
+    uint8_t* d = (uint8_t*)destination;
+    while (taille > 0) {
+        ssize_t lus = recv(fd, d, taille, 0);
+        if (lus < 0 && errno == EINTR) continue;
+        if (lus <= 0) return false;
+        d += lus;
+        taille -= (size_t)lus;
+    }
+    return true;
+}
+
+/**
+ * @brief Écrit exactement taille octets (sans SIGPIPE si le pair a fermé).
+ */
+static bool ecrireTout(int fd, const void* source, size_t taille) {
+    const uint8_t* s = (const uint8_t*)source;
+    while (taille > 0) {
+        ssize_t ecrits = send(fd, s, taille, MSG_NOSIGNAL);
+        if (ecrits < 0 && errno == EINTR) continue;
+        if (ecrits <= 0) return false;
+        s += ecrits;
+        taille -= (size_t)ecrits;
+    }
+    return true;
+}
+
+/**
+ * @brief Tampon d'octets extensible, réutilisé d'un message à l'autre.
+ */
+typedef struct {
+    uint8_t* octets;
+    size_t taille;
+    size_t capacite;
+} Tampon;
+
+static bool reserverTampon(Tampon* t, size_t capacite) {
+    if (capacite <= t->capacite) return true;
+    size_t nouvelle = t->capacite ? t->capacite : 4096;
+    while (nouvelle < capacite) nouvelle *= 2;
+    uint8_t* tmp = (uint8_t*)realloc(t->octets, nouvelle);
+    if (!tmp) return false;
+    t->octets = tmp;
+    t->capacite = nouvelle;
+    return true;
+}
+
+static bool ajouterTampon(Tampon* t, const void* source, size_t taille) {
+    if (!reserverTampon(t, t->taille + taille)) return false;
+    memcpy(t->octets + t->taille, source, taille);
+    t->taille += taille;
+    return true;
+}
+
+// ==========================================================
+// 2. DEMON
+// ==========================================================
+
+// Instance résidente : ses requêtes sont sérialisées par son propre verrou, celles des autres
+// instances s'exécutent en parallèle
+typedef struct {
+    SolveurTransport* s;          // NULL une fois libérée
+    pthread_mutex_t verrou;       // Tenu pendant une modification, une résolution ou la libération
+    int utilisateurs;             // Requêtes en cours sur l'instance (protégé par le verrou du démon)
+    bool liberee;                 // Retirée de la table (protégé par le verrou du démon)
+} InstanceDemon;
+
+typedef struct {
+    InstanceDemon** instances;    // instances[k] : identifiant k + 1 (NULL : emplacement libre)
+    int nb_instances;             // Emplacements utilisés ou libres
+    int capacite_instances;
+    PoolThreads* pool;            // Partagé entre instances : ses lots sont sérialisés
+    CacheSolutions* cache;        // Cache des solutions optimales (NULL : aucun), verrou interne
+    pthread_mutex_t verrou;       // Protège la table des instances et les connexions (jamais pendant un calcul)
+    pthread_cond_t fin_connexion; // Signalée à chaque connexion fermée
+    int* connexions;              // Descripteurs des connexions ouvertes
+    int nb_connexions;
+    int capacite_connexions;
+    atomic_bool arret;
+    int ecoute;
+} Demon;
+
+typedef struct {
+    Demon* d;
+    int fd;
+} Connexion;
+
+/**
+ * @brief Réserve l'instance pour une requête (verrou du démon pris brièvement). @return NULL si inconnue.
+ */
+static InstanceDemon* prendreInstance(Demon* d, uint32_t instance) {
+    InstanceDemon* inst = NULL;
+    pthread_mutex_lock(&d->verrou);
+    if (instance > 0 && instance <= (uint32_t)d->nb_instances) inst = d->instances[instance - 1];
+    if (inst) inst->utilisateurs++;
+    pthread_mutex_unlock(&d->verrou);
+    return inst;
+}
+
+/**
+ * @brief Fin de requête : une instance libérée quitte la table et disparaît avec son dernier utilisateur.
+ */
+static void rendreInstance(Demon* d, uint32_t instance, InstanceDemon* inst, bool a_liberer) {
+    pthread_mutex_lock(&d->verrou);
+    if (a_liberer) {
+        inst->liberee = true;
+        d->instances[instance - 1] = NULL;
+    }
+    inst->utilisateurs--;
+    bool detruire = inst->liberee && inst->utilisateurs == 0;
+    pthread_mutex_unlock(&d->verrou);
+    if (detruire) {
+        pthread_mutex_destroy(&inst->verrou);
+        free(inst);
+    }
+}
+
+/**
+ * @brief Range le solveur dans le premier emplacement libre. @return Son identifiant, 0 en cas d'erreur.
+ */
+static uint32_t enregistrerInstance(Demon* d, SolveurTransport* s) {
+    InstanceDemon* inst = (InstanceDemon*)calloc(1, sizeof(InstanceDemon));
+    if (!inst) return 0;
+    inst->s = s;
+    pthread_mutex_init(&inst->verrou, NULL);
+
+    uint32_t identifiant = 0;
+    pthread_mutex_lock(&d->verrou);
+    for (int k = 0; identifiant == 0 && k < d->nb_instances; k++)
+        if (!d->instances[k]) { d->instances[k] = inst; identifiant = (uint32_t)k + 1; }
+    if (identifiant == 0 && d->nb_instances == d->capacite_instances) {
+        int nouvelle = d->capacite_instances ? 2 * d->capacite_instances : 16;
+        InstanceDemon** tmp = (InstanceDemon**)realloc(d->instances, nouvelle * sizeof(InstanceDemon*));
+        if (tmp) { d->instances = tmp; d->capacite_instances = nouvelle; }
+    }
+    if (identifiant == 0 && d->nb_instances < d->capacite_instances) {
+        d->instances[d->nb_instances++] = inst;
+        identifiant = (uint32_t)d->nb_instances;
+    }
+    pthread_mutex_unlock(&d->verrou);
+    if (identifiant == 0) { pthread_mutex_destroy(&inst->verrou); free(inst); }
+    return identifiant;
+}
+
+static CodeRetour requeteCharger(Demon* d, const uint8_t* charge, uint32_t taille, uint32_t* instance) {
+    if (taille < 2 * sizeof(int32_t)) return RETOUR_ARGUMENT_INVALIDE;
+    int32_t n, m;
+    memcpy(&n, charge, sizeof(int32_t));
+    memcpy(&m, charge + sizeof(int32_t), sizeof(int32_t));
+    if (n <= 0 || m <= 0) return RETOUR_ARGUMENT_INVALIDE;
+    uint64_t attendu = 2 * sizeof(int32_t) + (uint64_t)n * m * sizeof(double) + ((uint64_t)n + m) * sizeof(int32_t);
+    if (attendu != taille) return RETOUR_ARGUMENT_INVALIDE;
+
+    // Le tampon de réception est aligné (malloc) et les couts commencent à l'octet 8
+    const double* couts = (const double*)(charge + 2 * sizeof(int32_t));
+    const int32_t* offres = (const int32_t*)(couts + (size_t)n * m);
+    SolveurTransport* s;
+    CodeRetour code = creerSolveur(n, m, couts, offres, offres + n, &s);
+    if (code != RETOUR_OK) return code;
+    *instance = enregistrerInstance(d, s);
+    if (*instance == 0) { libererSolveur(s); return RETOUR_MEMOIRE; }
+    return RETOUR_OK;
+}
+
+static CodeRetour requeteModifierCouts(SolveurTransport* s, const uint8_t* charge, uint32_t taille) {
+    if (taille < sizeof(int32_t)) return RETOUR_ARGUMENT_INVALIDE;
+    int32_t nb;
+    memcpy(&nb, charge, sizeof(int32_t));
+    if (nb < 0 || sizeof(int32_t) + (uint64_t)nb * sizeof(CoutModifie) != taille) return RETOUR_ARGUMENT_INVALIDE;
+
+    int* lignes = (int*)malloc((nb + 1) * sizeof(int));
+    int* colonnes = (int*)malloc((nb + 1) * sizeof(int));
+    double* couts = (double*)malloc((nb + 1) * sizeof(double));
+    CodeRetour code = RETOUR_MEMOIRE;
+    if (lignes && colonnes && couts) {
+        for (int k = 0; k < nb; k++) {
+            CoutModifie c;
+            memcpy(&c, charge + sizeof(int32_t) + (size_t)k * sizeof(CoutModifie), sizeof(CoutModifie));
+            lignes[k] = c.i; colonnes[k] = c.j; couts[k] = c.cout;
+        }
+        code = modifierCasesSolveur(s, nb, lignes, colonnes, couts);
+    }
+    free(lignes); free(colonnes); free(couts);
+    return code;
+}
+
+static CodeRetour requeteResoudre(Demon* d, SolveurTransport* s, const uint8_t* charge, uint32_t taille,
+                                  Tampon* reponse) {
+    if (taille != sizeof(ParametresResolution)) return RETOUR_ARGUMENT_INVALIDE;
+    ParametresResolution parametres;
+    memcpy(&parametres, charge, sizeof(parametres));
+    OptionsSolveur o;
+    optionsSolveurParDefaut(&o);
+    o.methode = (MethodeInitiale)parametres.methode;
+    o.reprendre_base = parametres.reprendre_base != 0;
+    if (parametres.max_iterations > 0) o.max_iterations = parametres.max_iterations;
+    o.delai_max = parametres.delai_max;
+    o.pool = d->pool;
+    o.cache = d->cache;
+
+    CodeRetour code = resoudreSolveur(s, &o);
+    const SolutionCreuse* sol = solutionSolveur(s);
+    if (!sol) return code;
+
+    const ResultatMarchePied* stats = resultatSolveur(s);
+    EnteteSolution entete = { sol->cout_total, stats->ecart_max, sol->n, sol->m, stats->pivots,
+                              stats->optimal, (int32_t)stats->cause, sol->nb_cases };
+    if (!reserverTampon(reponse, reponse->taille + sizeof(entete) + (size_t)sol->nb_cases * sizeof(CaseTransmise)))
+        return RETOUR_MEMOIRE;
+    ajouterTampon(reponse, &entete, sizeof(entete));
+    for (int k = 0; k < sol->nb_cases; k++) {
+        const CaseBase* c = &sol->cases[k];
+        CaseTransmise t = { c->i, c->j, c->quantite, 0, c->cout };
+        ajouterTampon(reponse, &t, sizeof(t));
+    }
+    return code;
+}
+
+/**
+ * @brief Exécute une requête. La charge utile de la réponse est ajoutée à reponse.
+ * Seul le verrou de l'instance visée est tenu pendant le calcul.
+ */
+static CodeRetour executerRequete(Demon* d, const EnteteMessage* e, const uint8_t* charge, Tampon* reponse,
+                                  uint32_t* instance) {
+    if (e->type == REQUETE_CHARGER) return requeteCharger(d, charge, e->taille, instance);
+    if (e->type == REQUETE_ARRETER) {
+        // Réveille accept() et les connexions en attente ; la réponse à cette requête part encore
+        atomic_store(&d->arret, true);
+        shutdown(d->ecoute, SHUT_RDWR);
+        return RETOUR_OK;
+    }
+
+    InstanceDemon* inst = prendreInstance(d, e->instance);
+    if (!inst) return RETOUR_ARGUMENT_INVALIDE;
+    CodeRetour code = RETOUR_ARGUMENT_INVALIDE;
+    bool liberation = false;
+    pthread_mutex_lock(&inst->verrou);
+    if (inst->s) {
+        switch (e->type) {
+            case REQUETE_MODIFIER_COUTS: code = requeteModifierCouts(inst->s, charge, e->taille); break;
+            case REQUETE_RESOUDRE: code = requeteResoudre(d, inst->s, charge, e->taille, reponse); break;
+            case REQUETE_LIBERER:
+                libererSolveur(inst->s);
+                inst->s = NULL;
+                liberation = true;
+                code = RETOUR_OK;
+                break;
+            default: break;
+        }
+    }
+    pthread_mutex_unlock(&inst->verrou);
+    rendreInstance(d, e->instance, inst, liberation);
+    return code;
+}
+
+static void fermerConnexion(Demon* d, int fd) {
+    pthread_mutex_lock(&d->verrou);
+    for (int k = 0; k < d->nb_connexions; k++)
+        if (d->connexions[k] == fd) { d->connexions[k] = d->connexions[--d->nb_connexions]; break; }
+    pthread_cond_signal(&d->fin_connexion);
+    pthread_mutex_unlock(&d->verrou);
+    close(fd);
+}
+
+static void* servirConnexion(void* arg) {
+    Connexion c = *(Connexion*)arg;
+    free(arg);
+    Demon* d = c.d;
+    Tampon requete = { NULL, 0, 0 }, reponse = { NULL, 0, 0 };
+    EnteteMessage e;
+
+    // Un message mal formé ferme la connexion : le flux ne peut plus être resynchronisé
+    while (lireTout(c.fd, &e, sizeof(e))) {
+        if (e.magie != PROTOCOLE_MAGIE || e.taille > PROTOCOLE_TAILLE_MAX) break;
+        if (!reserverTampon(&requete, e.taille) || !lireTout(c.fd, requete.octets, e.taille)) break;
+
+        EnteteMessage r = { PROTOCOLE_MAGIE, e.type, e.instance, RETOUR_OK, 0 };
+        reponse.taille = 0;
+        if (!reserverTampon(&reponse, sizeof(r))) break;
+        reponse.taille = sizeof(r);
+        r.code = executerRequete(d, &e, requete.octets, &reponse, &r.instance);
+        r.taille = (uint32_t)(reponse.taille - sizeof(r));
+        memcpy(reponse.octets, &r, sizeof(r));
+        if (!ecrireTout(c.fd, reponse.octets, reponse.taille)) break;
+    }
+
+    free(requete.octets);
+    free(reponse.octets);
+    fermerConnexion(d, c.fd);
+    return NULL;
+}
+
+/**
+ * @brief Enregistre la connexion puis lance son thread. @return false si le démon s'arrête ou en cas d'erreur.
+ */
+static bool accueillirConnexion(Demon* d, int fd) {
+    Connexion* c = (Connexion*)malloc(sizeof(Connexion));
+    bool ok = c != NULL;
+    pthread_mutex_lock(&d->verrou);
+    ok = ok && !atomic_load(&d->arret);
+    if (ok && d->nb_connexions == d->capacite_connexions) {
+        int nouvelle = d->capacite_connexions ? 2 * d->capacite_connexions : 8;
+        int* tmp = (int*)realloc(d->connexions, nouvelle * sizeof(int));
+        if (tmp) { d->connexions = tmp; d->capacite_connexions = nouvelle; }
+        ok = tmp != NULL;
+    }
+    pthread_t thread;
+    if (ok) {
+        c->d = d;
+        c->fd = fd;
+        ok = pthread_create(&thread, NULL, servirConnexion, c) == 0;
+    }
+    if (ok) {
+        d->connexions[d->nb_connexions++] = fd;
+        pthread_detach(thread);
+    }
+    pthread_mutex_unlock(&d->verrou);
+    if (!ok) { free(c); close(fd); }
+    return ok;
+}
+
+/**
+ * @brief Supprime chemin s'il désigne une socket (laissée par un démon précédent).
+ * @return false si chemin existe sans être une socket : il n'est jamais supprimé.
+ */
+static bool supprimerSocket(const char* chemin) {
+    struct stat st;
+    if (lstat(chemin, &st) != 0) return errno == ENOENT;
+    if (!S_ISSOCK(st.st_mode)) return false;
+    unlink(chemin);
+    return true;
+}
+
+bool lancerDemon(const char* chemin, int nb_threads, CacheSolutions* cache) {
+    struct sockaddr_un adresse;
+    memset(&adresse, 0, sizeof(adresse));
+    adresse.sun_family = AF_UNIX;
+    if (strlen(chemin) >= sizeof(adresse.sun_path)) return false;
+    strcpy(adresse.sun_path, chemin);
+
+    if (!supprimerSocket(chemin)) return false;
+    int ecoute = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (ecoute < 0) return false;
+    if (bind(ecoute, (struct sockaddr*)&adresse, sizeof(adresse)) < 0 || listen(ecoute, 64) < 0) {
+        close(ecoute);
+        return false;
+    }
+
+    Demon d;
+    memset(&d, 0, sizeof(d));
+    d.ecoute = ecoute;
+    d.cache = cache;
+    atomic_init(&d.arret, false);
+    pthread_mutex_init(&d.verrou, NULL);
+    pthread_cond_init(&d.fin_connexion, NULL);
+    if (nb_threads != 1) d.pool = creerPoolThreads(nb_threads); // NULL : résolutions séquentielles
+
+    while (!atomic_load(&d.arret)) {
+        int fd = accept(ecoute, NULL, NULL);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            break;
+        }
+        accueillirConnexion(&d, fd);
+    }
+
+    // Arrêt : les connexions encore ouvertes sont coupées, puis on attend la fin de leurs threads
+    pthread_mutex_lock(&d.verrou);
+    atomic_store(&d.arret, true);
+    for (int k = 0; k < d.nb_connexions; k++) shutdown(d.connexions[k], SHUT_RD);
+    while (d.nb_connexions > 0) pthread_cond_wait(&d.fin_connexion, &d.verrou);
+    pthread_mutex_unlock(&d.verrou);
+
+    close(ecoute);
+    supprimerSocket(chemin);
+    // Plus aucune connexion : aucune requête ne tient d'instance
+    for (int k = 0; k < d.nb_instances; k++) {
+        if (!d.instances[k]) continue;
+        libererSolveur(d.instances[k]->s);
+        pthread_mutex_destroy(&d.instances[k]->verrou);
+        free(d.instances[k]);
+    }
+    free(d.instances);
+    free(d.connexions);
+    libererPoolThreads(d.pool);
+    pthread_cond_destroy(&d.fin_connexion);
+    pthread_mutex_destroy(&d.verrou);
+    return true;
+}
+
+// ==========================================================
+// 3. CLIENT
+// ==========================================================
+
+int connecterDemon(const char* chemin) {
+    struct sockaddr_un adresse;
+    memset(&adresse, 0, sizeof(adresse));
+    adresse.sun_family = AF_UNIX;
+    if (strlen(chemin) >= sizeof(adresse.sun_path)) return -1;
+    strcpy(adresse.sun_path, chemin);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+    if (connect(fd, (struct sockaddr*)&adresse, sizeof(adresse)) < 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+void deconnecterDemon(int fd) {
+    if (fd >= 0) close(fd);
+}
+
+static bool envoyerEntete(int fd, uint32_t type, uint32_t instance, uint64_t taille) {
+    if (taille > PROTOCOLE_TAILLE_MAX) return false;
+    EnteteMessage e = { PROTOCOLE_MAGIE, type, instance, RETOUR_OK, (uint32_t)taille };
+    return ecrireTout(fd, &e, sizeof(e));
+}
+
+/**
+ * @brief Lit l'entête de la réponse à une requête de type `type`.
+ * @return Le code du démon, RETOUR_COMMUNICATION si la réponse est absente ou invalide.
+ */
+static CodeRetour recevoirReponse(int fd, uint32_t type, EnteteMessage* r) {
+    if (!lireTout(fd, r, sizeof(*r)) || r->magie != PROTOCOLE_MAGIE || r->type != type) return RETOUR_COMMUNICATION;
+    return (CodeRetour)r->code;
+}
+
+/**
+ * @brief Réponse sans charge utile attendue.
+ */
+static CodeRetour recevoirReponseVide(int fd, uint32_t type) {
+    EnteteMessage r;
+    CodeRetour code = recevoirReponse(fd, type, &r);
+    return (code != RETOUR_COMMUNICATION && r.taille != 0) ? RETOUR_COMMUNICATION : code;
+}
+
+CodeRetour demanderChargement(int fd, const ProblemeTransport* p, uint32_t* instance) {
+    int32_t dimensions[2] = { p->n, p->m };
+    uint64_t taille = sizeof(dimensions) + (uint64_t)p->n * p->m * sizeof(double)
+                      + ((uint64_t)p->n + p->m) * sizeof(int32_t);
+    if (taille > PROTOCOLE_TAILLE_MAX) return RETOUR_ARGUMENT_INVALIDE;
+
+    bool ok = envoyerEntete(fd, REQUETE_CHARGER, 0, taille) && ecrireTout(fd, dimensions, sizeof(dimensions));
+    for (int i = 0; ok && i < p->n; i++) ok = ecrireTout(fd, p->A[i], p->m * sizeof(double));
+    ok = ok && ecrireTout(fd, p->P, p->n * sizeof(int)) && ecrireTout(fd, p->C, p->m * sizeof(int));
+    if (!ok) return RETOUR_COMMUNICATION;
+
+    EnteteMessage r;
+    CodeRetour code = recevoirReponse(fd, REQUETE_CHARGER, &r);
+    if (code != RETOUR_COMMUNICATION && r.taille != 0) return RETOUR_COMMUNICATION;
+    if (code == RETOUR_OK) *instance = r.instance;
+    return code;
+}
+
+CodeRetour demanderModificationCouts(int fd, uint32_t instance, int nb, const CoutModifie* couts) {
+    if (nb < 0) return RETOUR_ARGUMENT_INVALIDE;
+    int32_t nb_envoyes = nb;
+    if (!envoyerEntete(fd, REQUETE_MODIFIER_COUTS, instance, sizeof(int32_t) + (uint64_t)nb * sizeof(CoutModifie))
+        || !ecrireTout(fd, &nb_envoyes, sizeof(nb_envoyes))
+        || !ecrireTout(fd, couts, (size_t)nb * sizeof(CoutModifie)))
+        return RETOUR_COMMUNICATION;
+    return recevoirReponseVide(fd, REQUETE_MODIFIER_COUTS);
+}
+
+CodeRetour demanderResolution(int fd, uint32_t instance, const OptionsSolveur* o,
+                              SolutionCreuse** solution, ResultatMarchePied* stats) {
+    *solution = NULL;
+    if (stats) memset(stats, 0, sizeof(*stats));
+    OptionsSolveur opt;
+    if (o) opt = *o;
+    else optionsSolveurParDefaut(&opt);
+    ParametresResolution parametres = { (int32_t)opt.methode, opt.reprendre_base, opt.max_iterations, 0, opt.delai_max };
+    if (!envoyerEntete(fd, REQUETE_RESOUDRE, instance, sizeof(parametres))
+        || !ecrireTout(fd, &parametres, sizeof(parametres)))
+        return RETOUR_COMMUNICATION;
+
+    EnteteMessage r;
+    CodeRetour code = recevoirReponse(fd, REQUETE_RESOUDRE, &r);
+    if (code == RETOUR_COMMUNICATION || r.taille == 0) return code;
+
+    EnteteSolution entete;
+    if (r.taille < sizeof(entete) || !lireTout(fd, &entete, sizeof(entete)) || entete.nb_cases < 0
+        || r.taille != sizeof(entete) + (uint64_t)entete.nb_cases * sizeof(CaseTransmise))
+        return RETOUR_COMMUNICATION;
+
+    // Les cases sont lues par blocs et ajoutées au fil de l'eau
+    SolutionCreuse* s = creerSolutionCreuse(entete.n, entete.m);
+    CaseTransmise bloc[256];
+    bool ok = true;
+    for (int lues = 0; lues < entete.nb_cases;) {
+        int nb = entete.nb_cases - lues < 256 ? entete.nb_cases - lues : 256;
+        if (!lireTout(fd, bloc, nb * sizeof(CaseTransmise))) { libererSolutionCreuse(s); return RETOUR_COMMUNICATION; }
+        for (int k = 0; ok && k < nb; k++)
+            ok = s && ajouterCaseBase(s, bloc[k].i, bloc[k].j, bloc[k].quantite, bloc[k].cout);
+        lues += nb;
+    }
+    if (!ok) { libererSolutionCreuse(s); return RETOUR_MEMOIRE; }
+    s->cout_total = entete.cout_total;
+
+    if (stats) {
+        stats->pivots = entete.pivots;
+        stats->optimal = entete.optimal != 0;
+        stats->cause = (CauseArret)entete.cause;
+        stats->cout_total = entete.cout_total;
+        stats->ecart_max = entete.ecart_max;
+    }
+    *solution = s;
+    return code;
+}
+
+CodeRetour demanderLiberation(int fd, uint32_t instance) {
+    if (!envoyerEntete(fd, REQUETE_LIBERER, instance, 0)) return RETOUR_COMMUNICATION;
+    return recevoirReponseVide(fd, REQUETE_LIBERER);
+}
+
+CodeRetour demanderArret(int fd) {
+    if (!envoyerEntete(fd, REQUETE_ARRETER, 0, 0)) return RETOUR_COMMUNICATION;
+    return recevoirReponseVide(fd, REQUETE_ARRETER);
+}
@@ -1,184 +1,329 @@
 /**
  * @file etude_complexite.c
- * @brief Programme d'analyse de la complexité (Console + Gnuplot).
+ * @brief Programme d'analyse de la complexité (Console + régression log-log, fichiers .dat pour Gnuplot).
  */
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
 #include <string.h>
+#include <math.h>
 #include "projet_ro.h"
 
 // Valeurs de n à tester
-// 7 tailles réparties de manière quasi-logarithmique
-const int TAILLES[] = {10, 20, 40, 60, 80, 100, 120};
-const int NB_TAILLES = 7;
+// 7 tailles réparties de manière quasi-logarithmique, puis les tailles où la mémoire devient limitante
+// (au-delà de ConfigEtude.taille_max, 120 par défaut, elles ne sont pas étudiées)
+const int TAILLES[] = {10, 20, 40, 60, 80, 100, 120, 250, 500, 1000, 2000, 3000, 5000};
+const int NB_TAILLES = 13;
 // 20 essais suffisent pour avoir une moyenne stable
 const int NB_ESSAIS = 20;
+// Tailles pour lesquelles le modèle ajusté prévoit le temps de résolution
+const int CIBLES_PREVISION[] = {1000, 5000, 10000};
+const int NB_CIBLES_PREVISION = 3;
 
-// Structure pour stocker les résultats
+// Mémoire d'une résolution (méthode initiale + Marche-Pied)
 typedef struct {
-    double theta_NO;  // Temps Nord-Ouest
-    double theta_BH;  // Temps Balas-Hammer
-    double t_NO;      // Temps Marche-Pied après NO
-    double t_BH;      // Temps Marche-Pied après BH
+    long long pic_tas;     // Octets : instance + pic du tas pendant la résolution
+    size_t octets_alloues; // Cumul des allocations de la résolution
+    long nb_allocations;   // Allocations de la résolution
+    long pic_resident_ko;  // Pic de mémoire résidente du processus (0 : indisponible)
+} MemoireEssai;
+
+// Structure pour stocker les résultats (indexée par MethodeInitiale)
+typedef struct {
+    double theta[NB_METHODES_INITIALES];  // Temps de la méthode initiale
+    double t[NB_METHODES_INITIALES];      // Temps du Marche-Pied qui suit
+    int pivots[NB_METHODES_INITIALES];    // Pivots du Marche-Pied qui suit
+    MesureMaterielle compteurs[NB_METHODES_INITIALES][NB_PHASES_MESUREES]; // Événements par phase (0 : non mesurés)
+    MemoireEssai memoire[NB_METHODES_INITIALES];
 } ResultatTemps;
 
+// Préfixes des colonnes de compteurs dans raw_n*.dat (ordre de PhaseMesuree et de CompteurMateriel)
+static const char* const NOMS_PHASES[NB_PHASES_MESUREES] = { "init", "mp", "pot", "prix", "cycle" };
+static const char* const NOMS_COMPTEURS[NB_COMPTEURS_MATERIELS] = { "cyc", "ins", "llc", "br" };
+
 // --- FONCTIONS UTILITAIRES ---
 
-ProblemeTransport* genererProblemeAleatoire(int n) {
+/**
+ * @brief Tirage pseudo-aléatoire (xorshift64*) sur un état local : l'étude ne touche pas à l'état
+ * global de rand(), et deux études peuvent tourner en même temps.
+ */
+static uint32_t tirageAleatoire(uint64_t* etat) {
+    uint64_t x = *etat;
+    x ^= x >> 12; x ^= x << 25; x ^= x >> 27;
+    *etat = x;
+    return (uint32_t)((x * 0x2545F4914F6CDD1DULL) >> 32);
+}
+
+ProblemeTransport* genererProblemeAleatoire(int n, uint64_t* etat) {
     ProblemeTransport* p = creerProbleme(n, n);
+    if (!p) return NULL;
 
     // 1. Coûts aléatoires
     for (int i = 0; i < n; i++) {
         for (int j = 0; j < n; j++) {
-            p->A[i][j] = (double)(rand() % 100 + 1);
+            p->A[i][j] = (double)(tirageAleatoire(etat) % 100 + 1);
         }
     }
+    actualiserCouts(p);
 
-    // 2. Garantir l'équilibre Offre/Demande
-    int** temp = (int**)malloc(n * sizeof(int*));
+    // 2. Garantir l'équilibre Offre/Demande : P et C sont les sommes des lignes / colonnes
+    // d'une matrice aléatoire (tirée case par case, sans la stocker)
+    for (int i = 0; i < n; i++) p->P[i] = 0;
+    for (int j = 0; j < n; j++) p->C[j] = 0;
     for (int i = 0; i < n; i++) {
-        temp[i] = (int*)malloc(n * sizeof(int));
         for (int j = 0; j < n; j++) {
-            temp[i][j] = rand() % 100 + 1;
+            int q = (int)(tirageAleatoire(etat) % 100 + 1);
+            p->P[i] += q;
+            p->C[j] += q;
         }
     }
 
-    for (int i = 0; i < n; i++) {
-        p->P[i] = 0;
-        for (int j = 0; j < n; j++) p->P[i] += temp[i][j];
+    return p;
+}
+
+// Pics (maximum sur les essais) et allocations moyennes d'une méthode
+static void afficherMemoireMethode(int k, int nb_essais, const ResultatTemps resultats[]) {
+    long long pic_tas = 0;
+    long pic_resident = 0;
+    double nb_allocations = 0, octets_alloues = 0;
+    for (int essai = 0; essai < nb_essais; essai++) {
+        const MemoireEssai* mem = &resultats[essai].memoire[k];
+        if (mem->pic_tas > pic_tas) pic_tas = mem->pic_tas;
+        if (mem->pic_resident_ko > pic_resident) pic_resident = mem->pic_resident_ko;
+        nb_allocations += (double)mem->nb_allocations;
+        octets_alloues += (double)mem->octets_alloues;
     }
-    for (int j = 0; j < n; j++) {
-        p->C[j] = 0;
-        for (int i = 0; i < n; i++) p->C[j] += temp[i][j];
+    if (!profilMemoireDisponible()) {
+        // Sans -DPROFIL_MEMOIRE : pic estimé par la mémoire résidente, allocations non comptées
+        printf("       Memoire : pic tas ~%.1f Mo (estime), pic RSS %.1f Mo\n",
+               pic_tas / 1048576.0, pic_resident / 1024.0);
+        return;
     }
-
-    for (int i = 0; i < n; i++) free(temp[i]);
-    free(temp);
-
-    return p;
+    printf("       Memoire : pic tas %.1f Mo, pic RSS %.1f Mo, %.0f allocations (%.1f Mo alloues)\n",
+           pic_tas / 1048576.0, pic_resident / 1024.0, nb_allocations / nb_essais,
+           octets_alloues / nb_essais / 1048576.0);
 }
 
-void executerBatterieTests(int n, ResultatTemps resultats[]) {
+// Une méthode inactive (plafond mémoire) n'est pas lancée : ses résultats restent à zéro
+void executerBatterieTests(int n, int nb_essais, const bool actives[], ResultatTemps resultats[],
+                           const OptionsMarchePied* options, uint64_t* etat) {
     printf("\n------------------------------------------------------------\n");
-    printf("   TEST TAILLE N = %d  (%d essais)\n", n, NB_ESSAIS);
+    printf("   TEST TAILLE N = %d  (%d essais)\n", n, nb_essais);
     printf("------------------------------------------------------------\n");
 
-    // Variables pour calculer la moyenne (RESTAURÉ)
-    double somme_NO = 0, somme_BH = 0;
-    double somme_MpNO = 0, somme_MpBH = 0;
+    // Variables pour calculer la moyenne
+    double somme_init[NB_METHODES_INITIALES] = {0};
+    double somme_mp[NB_METHODES_INITIALES] = {0};
+    long somme_pivots[NB_METHODES_INITIALES] = {0};
+
+    // Copie locale pour récupérer les statistiques du Marche-Pied
+    ResultatMarchePied stats;
+    OptionsMarchePied o = *options;
+    o.resultat = &stats;
 
-    for (int essai = 0; essai < NB_ESSAIS; essai++) {
+    for (int essai = 0; essai < nb_essais; essai++) {
         if (essai % 5 == 0) { printf("."); fflush(stdout); } // Barre de progression simple
 
-        ProblemeTransport* p = genererProblemeAleatoire(n);
-
-        // 1. Nord-Ouest
-        clock_t d = clock();
-        algoNordOuestSilencieux(p);
-        double t1 = ((double)(clock() - d)) / CLOCKS_PER_SEC;
-        resultats[essai].theta_NO = t1;
-        somme_NO += t1;
-
-        // 2. Marche-Pied (depuis NO)
-        d = clock();
-        algoMarchePiedSilencieux(p);
-        double t2 = ((double)(clock() - d)) / CLOCKS_PER_SEC;
-        resultats[essai].t_NO = t2;
-        somme_MpNO += t2;
-
-        reinitialiserSolution(p);
-
-        // 3. Balas-Hammer
-        d = clock();
-        algoBalasHammerSilencieux(p);
-        double t3 = ((double)(clock() - d)) / CLOCKS_PER_SEC;
-        resultats[essai].theta_BH = t3;
-        somme_BH += t3;
-
-        // 4. Marche-Pied (depuis BH)
-        d = clock();
-        algoMarchePiedSilencieux(p);
-        double t4 = ((double)(clock() - d)) / CLOCKS_PER_SEC;
-        resultats[essai].t_BH = t4;
-        somme_MpBH += t4;
+        memset(&resultats[essai], 0, sizeof(ResultatTemps));
+        debuterProfilMemoire();
+        ProblemeTransport* p = genererProblemeAleatoire(n, etat);
+        long long octets_instance = terminerProfilMemoire().pic_octets;
+        if (!p) continue;
+
+        for (int k = 0; k < NB_METHODES_INITIALES; k++) {
+            if (!actives[k]) continue;
+            reinitialiserSolution(p);
+            // Chaque méthode paie ses propres tris : pas de cache hérité de la méthode précédente
+            invaliderOrdresCouts(p);
+            reinitialiserPicResident();
+            debuterProfilMemoire();
+            MesureMaterielle depart;
+            if (o.compteurs) remettreCompteursAZero(o.compteurs);
+
+            // 1. Méthode initiale
+            clock_t d = clock();
+            if (o.compteurs) debuterPhase(o.compteurs, &depart);
+            appliquerMethodeInitiale(p, (MethodeInitiale)k, false);
+            if (o.compteurs) terminerPhase(o.compteurs, PHASE_METHODE_INITIALE, &depart);
+            double t1 = ((double)(clock() - d)) / CLOCKS_PER_SEC;
+            resultats[essai].theta[k] = t1;
+            somme_init[k] += t1;
+
+            // 2. Marche-Pied (potentiels, coûts marginaux et cycle mesurés à l'intérieur)
+            d = clock();
+            if (o.compteurs) debuterPhase(o.compteurs, &depart);
+            libererSolutionCreuse(algoMarchePiedOptions(p, &o));
+            if (o.compteurs) terminerPhase(o.compteurs, PHASE_MARCHE_PIED, &depart);
+            double t2 = ((double)(clock() - d)) / CLOCKS_PER_SEC;
+            ProfilMemoire profil = terminerProfilMemoire();
+            MemoireEssai* mem = &resultats[essai].memoire[k];
+            mem->pic_tas = octets_instance + profil.pic_octets;
+            mem->octets_alloues = profil.octets_alloues;
+            mem->nb_allocations = profil.nb_allocations;
+            mem->pic_resident_ko = picResidentKo();
+            for (int ph = 0; o.compteurs && ph < NB_PHASES_MESUREES; ph++)
+                resultats[essai].compteurs[k][ph] = *cumulPhase(o.compteurs, (PhaseMesuree)ph);
+            resultats[essai].t[k] = t2;
+            resultats[essai].pivots[k] = stats.pivots;
+            somme_mp[k] += t2;
+            somme_pivots[k] += stats.pivots;
+        }
 
         libererProbleme(p);
     }
 
     printf(" Termine !\n");
 
-    // --- AFFICHAGE CONSOLE (RESTAURÉ) ---
-    printf("   > Moyenne Nord-Ouest (Init)    : %.6f s\n", somme_NO / NB_ESSAIS);
-    printf("   > Moyenne Marche-Pied (post NO): %.6f s\n", somme_MpNO / NB_ESSAIS);
-    printf("   > Moyenne Balas-Hammer (Init)  : %.6f s\n", somme_BH / NB_ESSAIS);
-    printf("   > Moyenne Marche-Pied (post BH): %.6f s\n", somme_MpBH / NB_ESSAIS);
-
-    double total_NO = (somme_NO + somme_MpNO) / NB_ESSAIS;
-    double total_BH = (somme_BH + somme_MpBH) / NB_ESSAIS;
-
-    printf("\n   >>> TEMPS TOTAL MOYEN (NO + Optim) : %.6f s\n", total_NO);
-    printf("   >>> TEMPS TOTAL MOYEN (BH + Optim) : %.6f s\n", total_BH);
-
-    if (total_BH < total_NO) {
-        printf("   [CONCLUSION] Balas-Hammer est %.1fx plus rapide !\n", total_NO / total_BH);
-    } else {
-        printf("   [CONCLUSION] Nord-Ouest est plus rapide.\n");
+    // --- AFFICHAGE CONSOLE ---
+    int meilleure = -1;
+    double meilleur_total = 0;
+    for (int k = 0; k < NB_METHODES_INITIALES; k++) {
+        if (!actives[k]) continue;
+        const char* abr = abreviationMethodeInitiale((MethodeInitiale)k);
+        double total = (somme_init[k] + somme_mp[k]) / nb_essais;
+        printf("   > %-13s (Init)    : %.6f s\n", nomMethodeInitiale((MethodeInitiale)k), somme_init[k] / nb_essais);
+        printf("   > Marche-Pied (post %s)      : %.6f s  (%.1f pivots)\n",
+               abr, somme_mp[k] / nb_essais, (double)somme_pivots[k] / nb_essais);
+        printf("   >>> TEMPS TOTAL MOYEN (%s + Optim) : %.6f s\n", abr, total);
+        afficherMemoireMethode(k, nb_essais, resultats);
+        if (meilleure < 0 || total < meilleur_total) { meilleur_total = total; meilleure = k; }
+    }
+    if (meilleure < 0) return;
+
+    printf("   [CONCLUSION] %s est la plus rapide.\n", nomMethodeInitiale((MethodeInitiale)meilleure));
+
+    if (!o.compteurs) return;
+    // IPC des phases et part des cycles du Marche-Pied par sous-phase, cumulés sur les essais
+    printf("   Compteurs materiels (thread principal) :\n");
+    for (int k = 0; k < NB_METHODES_INITIALES; k++) {
+        double total[NB_PHASES_MESUREES][NB_COMPTEURS_MATERIELS] = {{0}};
+        double temps_actif = 0, temps_compte = 0;
+        long pivots = 0;
+        for (int essai = 0; essai < nb_essais; essai++) {
+            pivots += resultats[essai].pivots[k];
+            for (int ph = 0; ph < NB_PHASES_MESUREES; ph++)
+                for (int c = 0; c < NB_COMPTEURS_MATERIELS; c++)
+                    total[ph][c] += (double)resultats[essai].compteurs[k][ph].valeurs[c];
+            for (int ph = PHASE_METHODE_INITIALE; ph <= PHASE_MARCHE_PIED; ph++) {
+                temps_actif += (double)resultats[essai].compteurs[k][ph].temps_actif;
+                temps_compte += (double)resultats[essai].compteurs[k][ph].temps_compte;
+            }
+        }
+        double cycles_mp = total[PHASE_MARCHE_PIED][COMPTEUR_CYCLES];
+        if (cycles_mp <= 0.0 || total[PHASE_METHODE_INITIALE][COMPTEUR_CYCLES] <= 0.0) continue;
+        printf("   > %s : IPC init %.2f, IPC MP %.2f, %.0f defauts LLC et %.0f branchements rates par pivot\n",
+               abreviationMethodeInitiale((MethodeInitiale)k),
+               total[PHASE_METHODE_INITIALE][COMPTEUR_INSTRUCTIONS] / total[PHASE_METHODE_INITIALE][COMPTEUR_CYCLES],
+               total[PHASE_MARCHE_PIED][COMPTEUR_INSTRUCTIONS] / cycles_mp,
+               total[PHASE_MARCHE_PIED][COMPTEUR_DEFAUTS_LLC] / (pivots > 0 ? pivots : 1),
+               total[PHASE_MARCHE_PIED][COMPTEUR_BRANCHEMENTS_RATES] / (pivots > 0 ? pivots : 1));
+        printf("     cycles du MP : potentiels %.0f %%, couts marginaux %.0f %%, cycle %.0f %%\n",
+               100.0 * total[PHASE_POTENTIELS][COMPTEUR_CYCLES] / cycles_mp,
+               100.0 * total[PHASE_COUTS_MARGINAUX][COMPTEUR_CYCLES] / cycles_mp,
+               100.0 * total[PHASE_CYCLE][COMPTEUR_CYCLES] / cycles_mp);
+        if (temps_compte < temps_actif)
+            printf("     groupe multiplexe par le noyau : compte %.0f %% du temps, valeurs extrapolees\n",
+                   100.0 * temps_compte / temps_actif);
     }
 }
 
 // Sauvegarde au format .dat pour Gnuplot
-void sauvegarderResultatsDat(int n, ResultatTemps resultats[]) {
+// Les 7 premières colonnes (NO / BH) gardent leur position historique
+// Puis 16 colonnes mémoire : pic du tas et cumul alloué (octets), allocations, pic RSS (ko) par méthode
+// Avec les compteurs : 80 colonnes de plus, <compteur>_<phase>_<méthode> (ex. cyc_prix_BH)
+// @return false si le fichier n'a pas pu être écrit
+bool sauvegarderResultatsDat(int n, int nb_essais, ResultatTemps resultats[], bool avec_compteurs) {
     char nom_fichier[256];
     sprintf(nom_fichier, "raw_n%d.dat", n);
     FILE* f = fopen(nom_fichier, "w");
-    if (!f) return;
-
-    fprintf(f, "# essai theta_NO theta_BH t_NO t_BH total_NO total_BH\n");
-    for (int i = 0; i < NB_ESSAIS; i++) {
-        fprintf(f, "%d %.6f %.6f %.6f %.6f %.6f %.6f\n",
+    if (!f) return false;
+
+    const int NO = METHODE_NORD_OUEST, BH = METHODE_BALAS_HAMMER;
+    const int RU = METHODE_RUSSELL, MC = METHODE_MOINDRE_COUT;
+    fprintf(f, "# essai theta_NO theta_BH t_NO t_BH total_NO total_BH"
+               " theta_RU theta_MC t_RU t_MC total_RU total_MC"
+               " pivots_NO pivots_BH pivots_RU pivots_MC");
+    for (int k = 0; k < NB_METHODES_INITIALES; k++) {
+        const char* abr = abreviationMethodeInitiale((MethodeInitiale)k);
+        fprintf(f, " pic_tas_%s alloc_%s nb_alloc_%s rss_%s", abr, abr, abr, abr);
+    }
+    for (int k = 0; avec_compteurs && k < NB_METHODES_INITIALES; k++)
+        for (int ph = 0; ph < NB_PHASES_MESUREES; ph++)
+            for (int c = 0; c < NB_COMPTEURS_MATERIELS; c++)
+                fprintf(f, " %s_%s_%s", NOMS_COMPTEURS[c], NOMS_PHASES[ph], abreviationMethodeInitiale((MethodeInitiale)k));
+    fprintf(f, "\n");
+    for (int i = 0; i < nb_essais; i++) {
+        const ResultatTemps* r = &resultats[i];
+        fprintf(f, "%d %.6f %.6f %.6f %.6f %.6f %.6f %.6f %.6f %.6f %.6f %.6f %.6f %d %d %d %d",
                 i + 1,
-                resultats[i].theta_NO,
-                resultats[i].theta_BH,
-                resultats[i].t_NO,
-                resultats[i].t_BH,
-                resultats[i].theta_NO + resultats[i].t_NO,
-                resultats[i].theta_BH + resultats[i].t_BH);
+                r->theta[NO], r->theta[BH], r->t[NO], r->t[BH],
+                r->theta[NO] + r->t[NO], r->theta[BH] + r->t[BH],
+                r->theta[RU], r->theta[MC], r->t[RU], r->t[MC],
+                r->theta[RU] + r->t[RU], r->theta[MC] + r->t[MC],
+                r->pivots[NO], r->pivots[BH], r->pivots[RU], r->pivots[MC]);
+        for (int k = 0; k < NB_METHODES_INITIALES; k++)
+            fprintf(f, " %lld %zu %ld %ld", r->memoire[k].pic_tas, r->memoire[k].octets_alloues,
+                    r->memoire[k].nb_allocations, r->memoire[k].pic_resident_ko);
+        for (int k = 0; avec_compteurs && k < NB_METHODES_INITIALES; k++)
+            for (int ph = 0; ph < NB_PHASES_MESUREES; ph++)
+                for (int c = 0; c < NB_COMPTEURS_MATERIELS; c++)
+                    fprintf(f, " %llu", (unsigned long long)r->compteurs[k][ph].valeurs[c]);
+        fprintf(f, "\n");
     }
-    fclose(f);
+    return fclose(f) == 0;
 }
 
-// Lit les fichiers .dat bruts et crée le fichier de synthèse
-void sauvegarderSyntheseDat(const char* nom_fichier) {
+// Colonnes d'une ligne .dat (nombre lu, au plus max)
+static int lireColonnes(const char* ligne, double v[], int max) {
+    int nb = 0;
+    char* fin;
+    while (nb < max) {
+        v[nb] = strtod(ligne, &fin);
+        if (fin == ligne) break;
+        ligne = fin;
+        nb++;
+    }
+    return nb;
+}
+
+// Lit les fichiers .dat bruts des tailles mesurées par cette étude et crée le fichier de synthèse
+// (un raw_n*.dat laissé par une étude précédente n'y entre pas)
+// Colonnes 6 à 9 : pic du tas maximal par méthode en Mo (0 : méthode non lancée)
+void sauvegarderSyntheseDat(const char* nom_fichier, const int tailles[], int nb_tailles) {
     FILE* f = fopen(nom_fichier, "w");
     if (!f) return;
 
-    fprintf(f, "# n max_total_NO max_total_BH\n");
+    fprintf(f, "# n max_total_NO max_total_BH max_total_RU max_total_MC pic_Mo_NO pic_Mo_BH pic_Mo_RU pic_Mo_MC\n");
 
-    for (int idx = 0; idx < NB_TAILLES; idx++) {
-        int n = TAILLES[idx];
+    for (int idx = 0; idx < nb_tailles; idx++) {
+        int n = tailles[idx];
         char nom_brut[256];
         sprintf(nom_brut, "raw_n%d.dat", n);
         FILE* fb = fopen(nom_brut, "r");
         if (!fb) continue;
 
-        char ligne[512];
+        char ligne[4096]; // Lignes longues avec les colonnes des compteurs matériels
         fgets(ligne, sizeof(ligne), fb); // Sauter le header
 
-        double max_total_NO = 0, max_total_BH = 0;
-        // Lecture format espace
+        double max_total[4] = {0}, max_pic[4] = {0};
+        // Lecture format espace (colonnes total_NO, total_BH, total_RU, total_MC, puis pic_tas_XX)
         while (fgets(ligne, sizeof(ligne), fb)) {
-            int e;
-            double v[6];
-            if(sscanf(ligne, "%d %lf %lf %lf %lf %lf %lf",
-               &e, &v[0], &v[1], &v[2], &v[3], &v[4], &v[5]) == 7) {
-                if (v[4] > max_total_NO) max_total_NO = v[4];
-                if (v[5] > max_total_BH) max_total_BH = v[5];
+            double v[33];
+            int nb = lireColonnes(ligne, v, 33);
+            if (nb >= 13) {
+                if (v[5] > max_total[0]) max_total[0] = v[5];
+                if (v[6] > max_total[1]) max_total[1] = v[6];
+                if (v[11] > max_total[2]) max_total[2] = v[11];
+                if (v[12] > max_total[3]) max_total[3] = v[12];
             }
+            for (int k = 0; nb == 33 && k < 4; k++)
+                if (v[17 + 4 * k] > max_pic[k]) max_pic[k] = v[17 + 4 * k];
         }
         fclose(fb);
-        fprintf(f, "%d %.6f %.6f\n", n, max_total_NO, max_total_BH);
+        fprintf(f, "%d %.6f %.6f %.6f %.6f %.3f %.3f %.3f %.3f\n", n, max_total[0], max_total[1], max_total[2],
+                max_total[3], max_pic[0] / 1048576.0, max_pic[1] / 1048576.0, max_pic[2] / 1048576.0,
+                max_pic[3] / 1048576.0);
     }
     fclose(f);
 }
@@ -189,7 +334,7 @@ void genererScriptGnuplot() {
 
     fprintf(f, "set terminal pngcairo size 800,600 enhanced font 'Arial,10'\n");
     fprintf(f, "set output 'resultat_complexite.png'\n");
-    fprintf(f, "set title 'Comparaison des performances : Nord-Ouest vs Balas-Hammer'\n");
+    fprintf(f, "set title 'Comparaison des performances des methodes initiales'\n");
     fprintf(f, "set xlabel 'Taille de la matrice (n)'\n");
     fprintf(f, "set ylabel 'Temps total d execution (s)'\n");
     fprintf(f, "set grid\n");
@@ -198,41 +343,183 @@ void genererScriptGnuplot() {
     fprintf(f, "set logscale y 10\n");
 
     fprintf(f, "plot 'synthese.dat' using 1:2 with linespoints lw 2 title 'Nord-Ouest + MP', \\\n");
-    fprintf(f, "     'synthese.dat' using 1:3 with linespoints lw 2 title 'Balas-Hammer + MP'\n");
+    fprintf(f, "     'synthese.dat' using 1:3 with linespoints lw 2 title 'Balas-Hammer + MP', \\\n");
+    fprintf(f, "     'synthese.dat' using 1:4 with linespoints lw 2 title 'Russell + MP', \\\n");
+    fprintf(f, "     'synthese.dat' using 1:5 with linespoints lw 2 title 'Moindre cout + MP'\n");
 
     fclose(f);
 }
 
+// --- REGRESSION LOG-LOG ---
+
+// Modèle t = C * n^b ajusté par moindres carrés sur (ln n, ln t), un point par essai
+typedef struct {
+    long nb;
+    double sx, sy, sxx, sxy, syy;
+} AjustementLogLog;
+
+static void ajouterPoint(AjustementLogLog* a, int n, double t) {
+    if (t <= 0.0) return; // Méthode non lancée ou temps sous la résolution de clock()
+    double x = log((double)n), y = log(t);
+    a->nb++;
+    a->sx += x; a->sy += y;
+    a->sxx += x * x; a->sxy += x * y; a->syy += y * y;
+}
+
+// Quantile à 97,5 % de la loi de Student à nu degrés de liberté
+// (développement de Cornish-Fisher autour du quantile normal, erreur < 1 % dès nu = 2)
+static double quantileStudent975(long nu) {
+    if (nu <= 1) return 12.706;
+    const double z = 1.959964, z2 = z * z;
+    double g1 = z * (z2 + 1) / 4;
+    double g2 = z * ((5 * z2 + 16) * z2 + 3) / 96;
+    double g3 = z * (((3 * z2 + 19) * z2 + 17) * z2 - 15) / 384;
+    double g4 = z * ((((79 * z2 + 776) * z2 + 1482) * z2 - 1920) * z2 - 945) / 92160;
+    double v = (double)nu;
+    return z + g1 / v + g2 / (v * v) + g3 / (v * v * v) + g4 / (v * v * v * v);
+}
+
+// Exposant, constante et intervalles de confiance à 95 % par méthode, puis temps prévus aux tailles cibles
+static void afficherModeleComplexite(const AjustementLogLog ajustements[]) {
+    printf("\n=== MODELE EMPIRIQUE t = C * n^b (regression log-log, IC 95 %%) ===\n");
+    for (int k = 0; k < NB_METHODES_INITIALES; k++) {
+        const AjustementLogLog* a = &ajustements[k];
+        const char* nom = nomMethodeInitiale((MethodeInitiale)k);
+        double N = (double)a->nb;
+        double sxx = a->nb > 0 ? a->sxx - a->sx * a->sx / N : 0.0; // Sommes centrées
+        if (a->nb < 3 || sxx <= 1e-12) {
+            printf("   > %-13s : donnees insuffisantes (une seule taille ou moins de 3 essais)\n", nom);
+            continue;
+        }
+        double sxy = a->sxy - a->sx * a->sy / N, syy = a->syy - a->sy * a->sy / N;
+        double b = sxy / sxx;
+        double moy_x = a->sx / N, moy_y = a->sy / N;
+        double ln_c = moy_y - b * moy_x;
+        double residus = syy - b * sxy;
+        double s2 = residus > 0.0 ? residus / (N - 2) : 0.0;
+        double r2 = syy > 0.0 ? 1.0 - residus / syy : 1.0;
+        double q = quantileStudent975(a->nb - 2);
+        double err_b = sqrt(s2 / sxx);
+        double err_c = sqrt(s2 * (1.0 / N + moy_x * moy_x / sxx));
+
+        printf("   > %-13s : b = %.3f [%.3f ; %.3f], C = %.3e [%.3e ; %.3e], R2 = %.3f (%ld essais)\n",
+               nom, b, b - q * err_b, b + q * err_b,
+               exp(ln_c), exp(ln_c - q * err_c), exp(ln_c + q * err_c), r2, a->nb);
+        // Intervalle sur la droite ajustée en ln t : le temps prévu est la médiane du modèle
+        for (int c = 0; c < NB_CIBLES_PREVISION; c++) {
+            double x = log((double)CIBLES_PREVISION[c]);
+            double err = sqrt(s2 * (1.0 / N + (x - moy_x) * (x - moy_x) / sxx));
+            double y = ln_c + b * x;
+            printf("       n = %-6d : %.4g s [%.4g ; %.4g]\n",
+                   CIBLES_PREVISION[c], exp(y), exp(y - q * err), exp(y + q * err));
+        }
+    }
+}
+
 // --- FONCTION PRINCIPALE ---
 
+void configEtudeParDefaut(ConfigEtude* config) {
+    config->nb_threads_pricing = 1;
+    config->interactif = true;
+    config->graine = 0;
+    config->compteurs_materiels = false;
+    config->taille_max = 120;
+    config->nb_essais = NB_ESSAIS;
+    config->plafond_memoire = 0;
+}
+
 void lancer_etude_complete() {
+    ConfigEtude config;
+    configEtudeParDefaut(&config);
+    lancer_etude_configuree(&config);
+}
+
+void lancer_etude_configuree(const ConfigEtude* config) {
     printf("\n=== ETUDE DE COMPLEXITE (Console + Gnuplot) ===\n");
-    srand(time(NULL));
+    uint64_t etat = config->graine ? config->graine : ((uint64_t)time(NULL) | 1u);
+
+    // Pool créé une fois pour toute l'étude (aucune création de thread par pivot)
+    OptionsMarchePied options;
+    optionsMarchePiedParDefaut(&options);
+    if (config->nb_threads_pricing != 1) {
+        options.pool = creerPoolThreads(config->nb_threads_pricing);
+        printf("Couts marginaux paralleles : %d thread(s)\n", nbThreadsPool(options.pool));
+    }
+    if (config->compteurs_materiels) {
+        options.compteurs = ouvrirCompteursMateriels();
+        if (options.compteurs) printf("Compteurs materiels : cycles, instructions, defauts LLC, branchements rates\n");
+        else printf("[Info] Compteurs materiels indisponibles (perf_event_open refuse ou absent), temps seuls.\n");
+    }
 
-    for (int idx = 0; idx < NB_TAILLES; idx++) {
+    if (config->plafond_memoire > 0)
+        printf("Plafond memoire : %.0f Mo par resolution\n", config->plafond_memoire / 1048576.0);
+
+    // Plafond : une méthode dont le pic du tas (mesuré, ou extrapolé en n^2 depuis la taille précédente)
+    // dépasse le plafond n'est plus lancée aux tailles suivantes
+    bool actives[NB_METHODES_INITIALES];
+    long long pic_precedent[NB_METHODES_INITIALES] = {0};
+    AjustementLogLog ajustements[NB_METHODES_INITIALES];
+    memset(ajustements, 0, sizeof(ajustements));
+    int tailles_mesurees[NB_TAILLES];  // Tailles dont le raw_n*.dat vient de cette étude
+    int nb_mesurees = 0;
+    int n_precedent = 0;
+    for (int k = 0; k < NB_METHODES_INITIALES; k++) actives[k] = true;
+
+    for (int idx = 0; idx < NB_TAILLES && TAILLES[idx] <= config->taille_max; idx++) {
         int n = TAILLES[idx];
-        ResultatTemps* res = (ResultatTemps*)malloc(NB_ESSAIS * sizeof(ResultatTemps));
+        int nb_actives = 0;
+        for (int k = 0; k < NB_METHODES_INITIALES; k++) {
+            if (actives[k] && config->plafond_memoire > 0 && n_precedent > 0) {
+                double prevu = (double)pic_precedent[k] * ((double)n / n_precedent) * ((double)n / n_precedent);
+                if (prevu > (double)config->plafond_memoire) {
+                    printf("\n[Info] %s ne tient pas a n = %d (pic prevu %.0f Mo > plafond), ignoree.\n",
+                           nomMethodeInitiale((MethodeInitiale)k), n, prevu / 1048576.0);
+                    actives[k] = false;
+                }
+            }
+            nb_actives += actives[k];
+        }
+        if (nb_actives == 0) {
+            printf("\n[Info] Aucune methode ne tient dans le plafond memoire a n = %d : fin de l'etude.\n", n);
+            break;
+        }
+
+        ResultatTemps* res = (ResultatTemps*)malloc(config->nb_essais * sizeof(ResultatTemps));
         if(!res) continue;
 
-        executerBatterieTests(n, res); // Affiche les stats dans la console
-        sauvegarderResultatsDat(n, res); // Sauvegarde pour le graphique
+        executerBatterieTests(n, config->nb_essais, actives, res, &options, &etat); // Affiche les stats dans la console
+        if (sauvegarderResultatsDat(n, config->nb_essais, res, options.compteurs != NULL)) // Sauvegarde pour le graphique
+            tailles_mesurees[nb_mesurees++] = n;
+
+        for (int k = 0; k < NB_METHODES_INITIALES; k++) {
+            pic_precedent[k] = 0;
+            for (int essai = 0; essai < config->nb_essais; essai++) {
+                if (res[essai].memoire[k].pic_tas > pic_precedent[k]) pic_precedent[k] = res[essai].memoire[k].pic_tas;
+                ajouterPoint(&ajustements[k], n, res[essai].theta[k] + res[essai].t[k]);
+            }
+            if (actives[k] && config->plafond_memoire > 0 && pic_precedent[k] > config->plafond_memoire) {
+                printf("[Info] %s a depasse le plafond memoire a n = %d (%.0f Mo), ignoree ensuite.\n",
+                       nomMethodeInitiale((MethodeInitiale)k), n, pic_precedent[k] / 1048576.0);
+                actives[k] = false;
+            }
+        }
+        n_precedent = n;
         free(res);
     }
 
-    sauvegarderSyntheseDat("synthese.dat");
+    libererPoolThreads(options.pool);
+    fermerCompteursMateriels(options.compteurs);
+
+    sauvegarderSyntheseDat("synthese.dat", tailles_mesurees, nb_mesurees);
     genererScriptGnuplot();
 
+    afficherModeleComplexite(ajustements);
+
     printf("\n------------------------------------------------\n");
-    printf("Generation graphique...\n");
-    int ret = system("\"C:\\Program Files\\gnuplot\\bin\\gnuplot.exe\" script_plot.plt");
-    if (ret == 0) {
-        printf("Succes ! 'resultat_complexite.png' a ete cree.\n");
-        system("start resultat_complexite.png"); // Ouvre l'image
-    } else {
-        printf("[Info] Gnuplot n'est pas lance automatiquement (pas dans le PATH ?).\n");
-        printf("Vous pouvez generer le graphique manuellement avec : gnuplot script_plot.plt\n");
-    }
-
-    printf("\nAppuyez sur Entree pour revenir au menu...");
-    getchar(); getchar();
+    printf("Donnees : raw_n*.dat et synthese.dat (graphique facultatif : gnuplot script_plot.plt)\n");
+
+    if (config->interactif) {
+        printf("\nAppuyez sur Entree pour revenir au menu...");
+        getchar(); getchar();
+    }
 }
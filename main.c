@@ -9,6 +9,9 @@
 #include <string.h>
 #include "projet_ro.h"
 
+// Au-delà de ce nombre de cases, la solution est affichée sous forme creuse
+#define SEUIL_AFFICHAGE_DENSE 400
+
 // ==========================================================
 // UTILITAIRES D'AFFICHAGE
 // ==========================================================
@@ -66,6 +69,12 @@ void afficher_menu_actions() {
     printf(" 2. Comparer Nord-Ouest et Balas-Hammer\n");
     printf(" 3. Pipeline : Balas-Hammer + Marche-Pied\n");
     printf(" 4. Pipeline : Nord-Ouest + Marche-Pied\n");
+    printf(" 5. Exporter la derniere solution (CSV / JSON / binaire)\n");
+    printf(" 6. Pipeline : Russell + Marche-Pied\n");
+    printf(" 7. Pipeline : Moindre cout + Marche-Pied\n");
+    printf(" 8. Comparer les couts de toutes les methodes initiales\n");
+    printf(" 9. Portfolio : toutes les methodes en concurrence\n");
+    printf("10. Analyse de sensibilite de la derniere solution\n");
     // Option 5 supprimée ici car déplacée au menu principal
     printf(" 0. Fermer ce fichier et revenir au menu principal\n");
     afficher_ligne();
@@ -107,28 +116,21 @@ ProblemeTransport* charger_probleme_interactif() {
         }
 
         // Tentative de chargement
-        p = lireDonnees(nom_fichier);
+        CodeRetour code = chargerDonnees(nom_fichier, &p);
 
-        if (p == NULL) {
-            printf("\n/!\\ ERREUR : Impossible de charger '%s'\n", nom_fichier);
+        if (code == RETOUR_DESEQUILIBRE) {
+            printf("\n/!\\ ALERTE : PROBLEME NON EQUILIBRE\n");
             int reessayer = 0;
-            printf("Reessayer ? (1: Oui, 0: Non) : ");
+            printf("Charger un autre ? (1: Oui, 0: Non) : ");
             scanf("%d", &reessayer);
             if (reessayer == 0) return NULL;
             continue;
         }
 
-        // Verification equilibre
-        int sum_P = 0, sum_C = 0;
-        for (int i = 0; i < p->n; i++) sum_P += p->P[i];
-        for (int j = 0; j < p->m; j++) sum_C += p->C[j];
-
-        if (sum_P != sum_C) {
-            printf("\n/!\\ ALERTE : PROBLEME NON EQUILIBRE (%d vs %d)\n", sum_P, sum_C);
-            libererProbleme(p);
-            p = NULL;
+        if (p == NULL) {
+            printf("\n/!\\ ERREUR : Impossible de charger '%s'\n", nom_fichier);
             int reessayer = 0;
-            printf("Charger un autre ? (1: Oui, 0: Non) : ");
+            printf("Reessayer ? (1: Oui, 0: Non) : ");
             scanf("%d", &reessayer);
             if (reessayer == 0) return NULL;
             continue;
@@ -143,6 +145,12 @@ ProblemeTransport* charger_probleme_interactif() {
 // ACTIONS
 // ==========================================================
 
+// Affiche B en dense pour les petites instances, en creux sinon
+void afficher_solution(ProblemeTransport* p, const SolutionCreuse* sol) {
+    if (sol == NULL || p->n * p->m <= SEUIL_AFFICHAGE_DENSE) afficherTableauSolution(p);
+    else afficherSolutionCreuse(sol);
+}
+
 void action_afficher_donnees(ProblemeTransport* p) {
     printf("\n[ACTION] Affichage des donnees\n");
     afficher_separateur();
@@ -156,13 +164,11 @@ void action_comparer_initiaux(ProblemeTransport* p) {
     afficher_separateur();
 
     // Nord Ouest
-    algoNordOuest(p);
-    double cout_no = calculerCoutTotal(p);
+    double cout_no = algoNordOuest(p);
     printf(" -> Cout Nord-Ouest   : %.2f\n", cout_no);
 
     // Balas Hammer
-    algoBalasHammer(p);
-    double cout_bh = calculerCoutTotal(p);
+    double cout_bh = algoBalasHammer(p);
     printf(" -> Cout Balas-Hammer : %.2f\n", cout_bh);
 
     afficher_ligne();
@@ -171,34 +177,570 @@ void action_comparer_initiaux(ProblemeTransport* p) {
     else printf(" [CONCLUSION] Resultats identiques.\n");
 }
 
-void action_pipeline_balas(ProblemeTransport* p) {
-    printf("\n[ACTION] Pipeline : Balas-Hammer + Marche-Pied\n");
+void action_comparer_toutes_methodes(ProblemeTransport* p) {
+    printf("\n[ACTION] Comparaison des methodes initiales\n");
+    afficher_separateur();
+
+    MethodeInitiale meilleure = METHODE_NORD_OUEST;
+    double meilleur_cout = DBL_MAX;
+    for (int k = 0; k < NB_METHODES_INITIALES; k++) {
+        double cout = appliquerMethodeInitiale(p, (MethodeInitiale)k, false);
+        printf(" -> Cout %-13s: %.2f\n", nomMethodeInitiale((MethodeInitiale)k), cout);
+        if (cout < meilleur_cout) { meilleur_cout = cout; meilleure = (MethodeInitiale)k; }
+    }
+
+    afficher_ligne();
+    printf(" [CONCLUSION] %s donne le meilleur depart.\n", nomMethodeInitiale(meilleure));
+}
+
+SolutionCreuse* action_pipeline(ProblemeTransport* p, MethodeInitiale methode) {
+    printf("\n[ACTION] Pipeline : %s + Marche-Pied\n", nomMethodeInitiale(methode));
     afficher_separateur();
 
-    algoBalasHammerSilencieux(p);
-    double c1 = calculerCoutTotal(p);
-    printf("1. Initial (BH) : %.2f\n", c1);
+    double c1 = appliquerMethodeInitiale(p, methode, false);
+    printf("1. Initial (%s) : %.2f\n", abreviationMethodeInitiale(methode), c1);
 
-    algoMarchePied(p);
-    double c2 = calculerCoutTotal(p);
+    SolutionCreuse* sol = algoMarchePied(p);
+    double c2 = sol ? sol->cout_total : calculerCoutTotal(p);
     printf("2. Final (MP)   : %.2f\n", c2);
 
-    afficherTableauSolution(p);
+    afficher_solution(p, sol);
+    return sol;
+}
+
+void action_exporter_solution(const SolutionCreuse* sol) {
+    printf("\n[ACTION] Export de la solution\n");
+    if (sol == NULL) {
+        printf("\n/!\\ Aucune solution : lancez d'abord un pipeline (3 ou 4).\n");
+        return;
+    }
+    int format = 0;
+    char nom_fichier[256];
+    printf("Format (1: CSV, 2: JSON, 3: Binaire) : ");
+    if (scanf("%d", &format) != 1 || format < 1 || format > 3) {
+        printf("\n/!\\ Format invalide.\n");
+        while(getchar() != '\n');
+        return;
+    }
+    printf("Nom du fichier de sortie : ");
+    if (scanf("%255s", nom_fichier) != 1) return;
+
+    bool ok = (format == 1) ? exporterSolutionCSV(sol, nom_fichier)
+            : (format == 2) ? exporterSolutionJSON(sol, nom_fichier)
+            : exporterSolutionBinaire(sol, nom_fichier);
+    if (ok) printf("\n[OK] %d case(s) de base ecrite(s) dans '%s'\n", sol->nb_cases, nom_fichier);
+    else printf("\n/!\\ ERREUR : Ecriture de '%s' impossible\n", nom_fichier);
 }
 
-void action_pipeline_nordouest(ProblemeTransport* p) {
-    printf("\n[ACTION] Pipeline : Nord-Ouest + Marche-Pied\n");
+SolutionCreuse* action_portfolio(ProblemeTransport* p) {
+    printf("\n[ACTION] Portfolio : %d pipelines en concurrence\n", NB_METHODES_INITIALES);
     afficher_separateur();
 
-    algoNordOuestSilencieux(p);
-    double c1 = calculerCoutTotal(p);
-    printf("1. Initial (NO) : %.2f\n", c1);
+    MethodeInitiale methodes[NB_METHODES_INITIALES];
+    for (int k = 0; k < NB_METHODES_INITIALES; k++) methodes[k] = (MethodeInitiale)k;
+    OptionsMarchePied options;
+    optionsMarchePiedParDefaut(&options);
+    ResultatPortfolio res;
 
-    algoMarchePied(p);
-    double c2 = calculerCoutTotal(p);
-    printf("2. Final (MP)   : %.2f\n", c2);
+    SolutionCreuse* sol = resoudrePortfolio(p, methodes, NB_METHODES_INITIALES, &options, &res);
+    if (!sol) {
+        printf("\n/!\\ ERREUR : Memoire insuffisante\n");
+        return NULL;
+    }
+    printf(" -> Pipeline retenu : %s + Marche-Pied\n", nomMethodeInitiale(res.gagnante));
+    printf(" -> Optimalite      : %s (%d pivots)\n", res.optimal ? "prouvee" : "non prouvee", res.pivots);
+    printf(" -> Temps ecoule    : %.6f s\n", res.duree);
+    printf("2. Final (MP)   : %.2f\n", res.cout_total);
 
-    afficherTableauSolution(p);
+    afficher_solution(p, sol);
+    return sol;
+}
+
+void action_sensibilite(ProblemeTransport* p, const SolutionCreuse* sol) {
+    printf("\n[ACTION] Analyse de sensibilite\n");
+    afficher_separateur();
+    if (sol == NULL || sol->E_s == NULL) {
+        printf("/!\\ Aucune solution optimale prouvee : lancez d'abord un pipeline (options 3, 4, 6, 7 ou 9).\n");
+        return;
+    }
+    AnalyseSensibilite* a = analyserSensibilite(p, sol);
+    if (a == NULL) {
+        printf("/!\\ ERREUR : La base n'est pas un arbre couvrant ou memoire insuffisante\n");
+        return;
+    }
+    afficherAnalyseSensibilite(p, sol, a);
+
+    printf("\nPlage du second membre : P[i] et C[j] varient ensemble de delta.\n");
+    int i, j;
+    for (;;) {
+        printf("Couple (i j), -1 pour terminer : ");
+        if (scanf("%d", &i) != 1 || i < 0) break;
+        if (scanf("%d", &j) != 1 || j < 0) break;
+        if (i >= p->n || j >= p->m) { printf("/!\\ Indices hors limites.\n"); continue; }
+        int dmin, dmax;
+        double prix = plageSecondMembre(a, i, j, &dmin, &dmax);
+        printf(" -> delta dans [%d, ", dmin);
+        if (dmax == INT_MAX) printf("+inf");
+        else printf("%d", dmax);
+        printf("], cout optimal %+.2f par unite\n", prix);
+    }
+    while(getchar() != '\n');
+    libererAnalyseSensibilite(a);
+}
+
+// ==========================================================
+// MODE BATCH
+// ==========================================================
+
+void afficher_usage_batch(const char* prog) {
+    printf("Usage : %s <fichier.txt> [options]\n", prog);
+    printf("        %s --etude [--threads <n>] [--graine <n>] [--compteurs]  (--compteurs : perf_event, Linux)\n", prog);
+    printf("               [--taille-max <n>] [--essais <k>] [--plafond-memoire <Mo>]  (tailles jusqu'a 5000)\n");
+    printf("        %s --reseau <fichier> [--iterations <n>] [--delai-ms <n>]  (transbordement)\n", prog);
+    printf("        %s --demon <socket> [--threads <n>] [--cache <k>] [--cache-fichier <f>]  (instances residentes)\n", prog);
+    printf("        %s --client <socket> <fichier.txt> [--init no|bh|ru|mc] [--repetitions <k>] [--arreter]\n", prog);
+    printf("  --init no|bh|ru|mc  Solution initiale (defaut : bh)\n");
+    printf("  --csv <fichier>  Export CSV de la solution creuse\n");
+    printf("  --json <fichier> Export JSON de la solution creuse\n");
+    printf("  --bin <fichier>  Export binaire de la solution creuse\n");
+    printf("  --dual <fichier> Export CSV des potentiels (certificat d'optimalite)\n");
+    printf("  --sensibilite    Plages des couts des cases de base (solution optimale)\n");
+    printf("  --verifier       Verifie le certificat d'optimalite (primal, dual, ecart)\n");
+    printf("  --trace console|jsonl|bin  Format de trace du Marche-Pied (defaut : aucune)\n");
+    printf("  --trace-fichier <fichier>  Destination de la trace jsonl/bin\n");
+    printf("  --trace-niveau 1|2|3       Resume, iterations ou detaillee (defaut : 2)\n");
+    printf("  --trace-pas <k>            Une iteration tracee sur k (defaut : 1)\n");
+    printf("  --threads <n>    Couts marginaux calcules sur n threads (0 : tous les coeurs)\n");
+    printf("  --delai-ms <n>   Echeance en millisecondes (meilleure solution obtenue + borne d'ecart)\n");
+    printf("  --iterations <n> Budget de pivots du Marche-Pied (defaut : 5000)\n");
+    printf("  --portfolio      Toutes les methodes initiales en concurrence (ignore --init, --trace, --threads)\n");
+    printf("  --produits <f>   Multi-produits : K, puis K fois n offres et m demandes (A partagee, --threads)\n");
+    printf("  --decomposer     Blocs independants (liaisons de cout >= seuil fermees) resolus en parallele (--threads)\n");
+    printf("  --seuil-interdit <c>  Cout de fermeture d'une liaison pour --decomposer (defaut : 1e9)\n");
+    printf("  --reduire        Reduction prealable (lignes / colonnes vides, affectations forcees, doublons fusionnes)\n");
+    printf("  --cache <f>      Cache de solutions sur disque : instance connue servie sans pivot, meme A : base reprise\n");
+}
+
+int executer_etude_batch(int argc, char* argv[]) {
+    ConfigEtude config;
+    configEtudeParDefaut(&config);
+    for (int a = 2; a < argc; a++) {
+        if (a + 1 < argc && strcmp(argv[a], "--threads") == 0) config.nb_threads_pricing = atoi(argv[++a]);
+        else if (a + 1 < argc && strcmp(argv[a], "--graine") == 0) config.graine = strtoull(argv[++a], NULL, 10);
+        else if (strcmp(argv[a], "--compteurs") == 0) config.compteurs_materiels = true;
+        else if (a + 1 < argc && strcmp(argv[a], "--taille-max") == 0) config.taille_max = atoi(argv[++a]);
+        else if (a + 1 < argc && strcmp(argv[a], "--essais") == 0) config.nb_essais = atoi(argv[++a]);
+        else if (a + 1 < argc && strcmp(argv[a], "--plafond-memoire") == 0)
+            config.plafond_memoire = (long long)(atof(argv[++a]) * 1048576.0);
+        else { afficher_usage_batch(argv[0]); return EXIT_FAILURE; }
+    }
+    if (config.nb_essais <= 0 || config.plafond_memoire < 0) { afficher_usage_batch(argv[0]); return EXIT_FAILURE; }
+    config.interactif = false;
+    lancer_etude_configuree(&config);
+    return EXIT_SUCCESS;
+}
+
+int executer_reseau_batch(int argc, char* argv[]) {
+    if (argc < 3) { afficher_usage_batch(argv[0]); return EXIT_FAILURE; }
+    OptionsMarchePied options;
+    optionsMarchePiedParDefaut(&options);
+    options.max_iterations = INT_MAX; // Le simplexe des réseaux ne cycle pas : pas de budget par défaut
+    for (int a = 3; a < argc; a++) {
+        if (a + 1 < argc && strcmp(argv[a], "--iterations") == 0) options.max_iterations = atoi(argv[++a]);
+        else if (a + 1 < argc && strcmp(argv[a], "--delai-ms") == 0) options.delai_max = atof(argv[++a]) / 1000.0;
+        else { afficher_usage_batch(argv[0]); return EXIT_FAILURE; }
+    }
+
+    ReseauTransbordement* r = lireReseau(argv[2]);
+    if (r == NULL) {
+        printf("/!\\ ERREUR : Impossible de charger '%s'\n", argv[2]);
+        return EXIT_FAILURE;
+    }
+    ResultatMarchePied stats;
+    options.resultat = &stats;
+    double debut = horlogeMurale();
+    bool admissible = resoudreTransbordement(r, &options);
+    double duree = horlogeMurale() - debut;
+
+    int code = EXIT_SUCCESS;
+    if (!admissible) {
+        printf("/!\\ ERREUR : Reseau desequilibre, irrealisable ou non borne\n");
+        code = EXIT_FAILURE;
+    } else {
+        afficherFluxReseau(r);
+        printf("Arret        : %s apres %d pivots (%d degeneres, %.6f s)\n",
+               nomCauseArret(stats.cause), stats.pivots, stats.pas_degeneres, duree);
+        printf("Final (RS)   : %.2f\n", stats.cout_total);
+    }
+    libererReseau(r);
+    return code;
+}
+
+int executer_demon_batch(int argc, char* argv[]) {
+    if (argc < 3) { afficher_usage_batch(argv[0]); return EXIT_FAILURE; }
+    int nb_threads = 1;
+    int taille_cache = TAILLE_CACHE_DEFAUT;
+    const char* fichier_cache = NULL;
+    for (int a = 3; a < argc; a++) {
+        if (a + 1 < argc && strcmp(argv[a], "--threads") == 0) nb_threads = atoi(argv[++a]);
+        else if (a + 1 < argc && strcmp(argv[a], "--cache") == 0) taille_cache = atoi(argv[++a]);
+        else if (a + 1 < argc && strcmp(argv[a], "--cache-fichier") == 0) fichier_cache = argv[++a];
+        else { afficher_usage_batch(argv[0]); return EXIT_FAILURE; }
+    }
+    CacheSolutions* cache = creerCacheSolutions(taille_cache); // NULL si taille_cache <= 0 : sans cache
+    if (cache && fichier_cache) chargerCacheSolutions(cache, fichier_cache);
+
+    printf("Demon en ecoute sur '%s' (arret : --client ... --arreter)\n", argv[2]);
+    fflush(stdout);
+    int code = EXIT_SUCCESS;
+    if (!lancerDemon(argv[2], nb_threads, cache)) {
+        printf("/!\\ ERREUR : Impossible d'ouvrir la socket '%s'\n", argv[2]);
+        code = EXIT_FAILURE;
+    } else {
+        printf("Demon arrete.\n");
+    }
+    if (cache) {
+        StatistiquesCache stats = statistiquesCache(cache);
+        printf("Cache        : %d entrees, %ld exactes, %ld voisines, %ld absentes, %ld evictions\n",
+               stats.entrees, stats.exacts, stats.voisins, stats.absents, stats.evictions);
+        if (fichier_cache && !sauverCacheSolutions(cache, fichier_cache)) code = EXIT_FAILURE;
+    }
+    libererCacheSolutions(cache);
+    return code;
+}
+
+/**
+ * @brief Client de démonstration : charge le fichier dans le démon, le résout, puis enchaîne
+ * des modifications de coûts et des re-résolutions à chaud en mesurant les temps aller-retour.
+ */
+int executer_client_batch(int argc, char* argv[]) {
+    if (argc < 4) { afficher_usage_batch(argv[0]); return EXIT_FAILURE; }
+    OptionsSolveur options;
+    optionsSolveurParDefaut(&options);
+    int repetitions = 100;
+    bool arreter = false;
+    for (int a = 4; a < argc; a++) {
+        if (a + 1 < argc && strcmp(argv[a], "--init") == 0) {
+            if (!lireMethodeInitiale(argv[++a], &options.methode)) { afficher_usage_batch(argv[0]); return EXIT_FAILURE; }
+        }
+        else if (a + 1 < argc && strcmp(argv[a], "--repetitions") == 0) repetitions = atoi(argv[++a]);
+        else if (strcmp(argv[a], "--arreter") == 0) arreter = true;
+        else { afficher_usage_batch(argv[0]); return EXIT_FAILURE; }
+    }
+
+    ProblemeTransport* p = lireDonnees(argv[3]);
+    if (p == NULL) {
+        printf("/!\\ ERREUR : Impossible de charger '%s'\n", argv[3]);
+        return EXIT_FAILURE;
+    }
+    int fd = connecterDemon(argv[2]);
+    if (fd < 0) {
+        printf("/!\\ ERREUR : Demon injoignable sur '%s'\n", argv[2]);
+        libererProbleme(p);
+        return EXIT_FAILURE;
+    }
+
+    uint32_t instance = 0;
+    SolutionCreuse* sol = NULL;
+    ResultatMarchePied stats;
+    double debut = horlogeMurale();
+    CodeRetour code = demanderChargement(fd, p, &instance);
+    double duree_chargement = horlogeMurale() - debut;
+    if (code == RETOUR_OK) {
+        debut = horlogeMurale();
+        code = demanderResolution(fd, instance, &options, &sol, &stats);
+        double duree = horlogeMurale() - debut;
+        printf("Chargement   : instance %u (%.6f s)\n", instance, duree_chargement);
+        printf("Resolution   : %s, %.2f en %d pivots (%.6f s)\n", messageRetour(code),
+               sol ? sol->cout_total : 0.0, stats.pivots, duree);
+    }
+
+    // Rondes : requête vide (latence du protocole), puis 10 coûts modifiés et re-résolution à chaud
+    double latence = 0.0, re_resolution = 0.0;
+    int pivots = 0, rondes = 0;
+    unsigned graine = 12345u;
+    options.reprendre_base = true;
+    for (; code <= RETOUR_ARRET_ANTICIPE && rondes < repetitions; rondes++) {
+        debut = horlogeMurale();
+        code = demanderModificationCouts(fd, instance, 0, NULL);
+        latence += horlogeMurale() - debut;
+
+        CoutModifie couts[10];
+        for (int k = 0; code == RETOUR_OK && k < 10; k++) {
+            graine = graine * 1103515245u + 12345u;
+            int i = (int)((graine >> 8) % (unsigned)p->n);
+            graine = graine * 1103515245u + 12345u;
+            int j = (int)((graine >> 8) % (unsigned)p->m);
+            p->A[i][j] += 1.0;
+            couts[k] = (CoutModifie){ i, j, p->A[i][j] };
+        }
+        debut = horlogeMurale();
+        if (code == RETOUR_OK) code = demanderModificationCouts(fd, instance, 10, couts);
+        libererSolutionCreuse(sol);
+        sol = NULL;
+        if (code == RETOUR_OK) code = demanderResolution(fd, instance, &options, &sol, &stats);
+        re_resolution += horlogeMurale() - debut;
+        pivots += stats.pivots;
+    }
+    if (rondes > 0 && code <= RETOUR_ARRET_ANTICIPE) {
+        printf("Rondes       : %d (10 couts modifies + re-resolution a chaud)\n", rondes);
+        printf("Latence      : %.1f us par requete vide\n", 1e6 * latence / rondes);
+        printf("Re-resolution: %.1f us en moyenne (%.1f pivots)\n", 1e6 * re_resolution / rondes,
+               (double)pivots / rondes);
+        // Contrôle : même problème modifié, résolu localement
+        actualiserCouts(p);
+        SolutionCreuse* locale = resoudreAnytime(p, options.methode, NULL, NULL);
+        if (locale && sol)
+            printf("Controle     : demon %.2f, local %.2f\n", sol->cout_total, locale->cout_total);
+        libererSolutionCreuse(locale);
+    }
+    if (code > RETOUR_ARRET_ANTICIPE) printf("/!\\ ERREUR : %s\n", messageRetour(code));
+
+    if (instance != 0 && code != RETOUR_COMMUNICATION) demanderLiberation(fd, instance);
+    if (arreter && code != RETOUR_COMMUNICATION) demanderArret(fd);
+    deconnecterDemon(fd);
+    libererSolutionCreuse(sol);
+    libererProbleme(p);
+    return code <= RETOUR_ARRET_ANTICIPE ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/**
+ * @brief Mode multi-produits : les seconds membres du fichier sont résolus sur la matrice A de p.
+ */
+int executer_multi_produits(const ProblemeTransport* p, const char* fichier, MethodeInitiale init,
+                            const OptionsMarchePied* options, int nb_threads) {
+    FILE* f = fopen(fichier, "r");
+    if (!f) { perror("Erreur ouverture fichier"); return EXIT_FAILURE; }
+    int nb = 0;
+    bool ok = fscanf(f, "%d", &nb) == 1 && nb > 0;
+    ProduitTransport* produits = ok ? (ProduitTransport*)calloc(nb, sizeof(ProduitTransport)) : NULL;
+    ok = produits != NULL;
+    for (int q = 0; ok && q < nb; q++) {
+        produits[q].P = (int*)malloc(p->n * sizeof(int));
+        produits[q].C = (int*)malloc(p->m * sizeof(int));
+        ok = produits[q].P && produits[q].C;
+        for (int i = 0; ok && i < p->n; i++) ok = fscanf(f, "%d", &produits[q].P[i]) == 1;
+        for (int j = 0; ok && j < p->m; j++) ok = fscanf(f, "%d", &produits[q].C[j]) == 1;
+    }
+    fclose(f);
+
+    int code = EXIT_SUCCESS;
+    if (!ok) {
+        printf("/!\\ ERREUR : Fichier de produits invalide '%s'\n", fichier);
+        code = EXIT_FAILURE;
+    } else {
+        double debut = horlogeMurale();
+        if (!resoudreMultiProduits(p, produits, nb, init, options, nb_threads)) code = EXIT_FAILURE;
+        double duree = horlogeMurale() - debut;
+        int chauds = 0, pivots = 0;
+        for (int q = 0; q < nb; q++) {
+            if (!produits[q].solution) { printf("Produit %-4d : /!\\ pas de solution\n", q); continue; }
+            printf("Produit %-4d : %12.2f (%s, %s, %d pivots)\n", q, produits[q].solution->cout_total,
+                   produits[q].demarrage_chaud ? "base voisine" : abreviationMethodeInitiale(init),
+                   nomCauseArret(produits[q].stats.cause), produits[q].stats.pivots);
+            chauds += produits[q].demarrage_chaud;
+            pivots += produits[q].stats.pivots;
+        }
+        printf("Multi-produits : %d produits, %d demarrages a chaud, %d pivots, %.6f s\n", nb, chauds, pivots, duree);
+    }
+    for (int q = 0; produits && q < nb; q++) {
+        free(produits[q].P); free(produits[q].C);
+        libererSolutionCreuse(produits[q].solution);
+    }
+    free(produits);
+    return code;
+}
+
+/**
+ * @brief Ligne "Arret" du mode batch ; sans borne d'écart si l'instance capacitée est irréalisable.
+ */
+void afficher_arret(const ResultatMarchePied* stats, const char* portee) {
+    if (stats->cause == ARRET_IRREALISABLE)
+        printf("Arret        : %s apres %d pivots%s\n", nomCauseArret(stats->cause), stats->pivots, portee);
+    else
+        printf("Arret        : %s apres %d pivots%s (ecart a l'optimum <= %.2f)\n",
+               nomCauseArret(stats->cause), stats->pivots, portee, stats->ecart_max);
+}
+
+int executer_mode_batch(int argc, char* argv[]) {
+    MethodeInitiale init = METHODE_BALAS_HAMMER;
+    const char* csv = NULL;
+    const char* json = NULL;
+    const char* bin = NULL;
+    const char* dual = NULL;
+    bool verifier = false;
+    bool sensibilite = false;
+    const char* trace_fichier = NULL;
+    TraceMarchePied trace = { TRACE_ITERATIONS, 1, TRACE_CONSOLE, stdout };
+    bool avec_trace = false;
+    int nb_threads = 1;
+    bool portfolio = false;
+    const char* produits = NULL;
+    double delai_ms = 0.0;
+    int budget_iterations = 0;
+    const char* fichier_cache = NULL;
+    bool decomposer = false;
+    double seuil_interdit = SEUIL_COUT_INTERDIT;
+    bool reduire = false;
+
+    for (int a = 2; a < argc; a++) {
+        if (a + 1 < argc && strcmp(argv[a], "--init") == 0) {
+            if (!lireMethodeInitiale(argv[++a], &init)) { afficher_usage_batch(argv[0]); return EXIT_FAILURE; }
+        }
+        else if (a + 1 < argc && strcmp(argv[a], "--csv") == 0) csv = argv[++a];
+        else if (a + 1 < argc && strcmp(argv[a], "--json") == 0) json = argv[++a];
+        else if (a + 1 < argc && strcmp(argv[a], "--bin") == 0) bin = argv[++a];
+        else if (a + 1 < argc && strcmp(argv[a], "--dual") == 0) dual = argv[++a];
+        else if (strcmp(argv[a], "--verifier") == 0) verifier = true;
+        else if (strcmp(argv[a], "--sensibilite") == 0) sensibilite = true;
+        else if (a + 1 < argc && strcmp(argv[a], "--trace") == 0) {
+            const char* format = argv[++a];
+            avec_trace = true;
+            if (strcmp(format, "jsonl") == 0) trace.format = TRACE_JSONL;
+            else if (strcmp(format, "bin") == 0) trace.format = TRACE_BINAIRE;
+            else trace.format = TRACE_CONSOLE;
+        }
+        else if (a + 1 < argc && strcmp(argv[a], "--trace-fichier") == 0) trace_fichier = argv[++a];
+        else if (a + 1 < argc && strcmp(argv[a], "--trace-niveau") == 0) trace.niveau = (NiveauTrace)atoi(argv[++a]);
+        else if (a + 1 < argc && strcmp(argv[a], "--trace-pas") == 0) trace.echantillonnage = atoi(argv[++a]);
+        else if (a + 1 < argc && strcmp(argv[a], "--threads") == 0) nb_threads = atoi(argv[++a]);
+        else if (a + 1 < argc && strcmp(argv[a], "--delai-ms") == 0) delai_ms = atof(argv[++a]);
+        else if (a + 1 < argc && strcmp(argv[a], "--iterations") == 0) budget_iterations = atoi(argv[++a]);
+        else if (strcmp(argv[a], "--portfolio") == 0) portfolio = true;
+        else if (a + 1 < argc && strcmp(argv[a], "--produits") == 0) produits = argv[++a];
+        else if (a + 1 < argc && strcmp(argv[a], "--cache") == 0) fichier_cache = argv[++a];
+        else if (strcmp(argv[a], "--decomposer") == 0) decomposer = true;
+        else if (a + 1 < argc && strcmp(argv[a], "--seuil-interdit") == 0) seuil_interdit = atof(argv[++a]);
+        else if (strcmp(argv[a], "--reduire") == 0) reduire = true;
+        else { afficher_usage_batch(argv[0]); return EXIT_FAILURE; }
+    }
+
+    ProblemeTransport* p = lireDonnees(argv[1]);
+    if (p == NULL) {
+        printf("/!\\ ERREUR : Impossible de charger '%s'\n", argv[1]);
+        return EXIT_FAILURE;
+    }
+
+    OptionsMarchePied options;
+    optionsMarchePiedParDefaut(&options);
+    if (delai_ms > 0.0) options.delai_max = delai_ms / 1000.0;
+    if (budget_iterations > 0) options.max_iterations = budget_iterations;
+    if (produits) {
+        int code = executer_multi_produits(p, produits, init, &options, nb_threads);
+        libererProbleme(p);
+        return code;
+    }
+    SolutionCreuse* sol = NULL;
+    ResultatMarchePied stats;
+
+    if (portfolio) {
+        MethodeInitiale methodes[NB_METHODES_INITIALES];
+        for (int k = 0; k < NB_METHODES_INITIALES; k++) methodes[k] = (MethodeInitiale)k;
+        ResultatPortfolio res;
+        sol = resoudrePortfolio(p, methodes, NB_METHODES_INITIALES, &options, &res);
+        if (sol) printf("Portfolio    : %s retenu (%s, %d pivots, %.6f s)\n", nomMethodeInitiale(res.gagnante),
+                        res.optimal ? "optimal" : "non prouve", res.pivots, res.duree);
+        avec_trace = false;
+        nb_threads = 1;
+    }
+
+    if (!portfolio && avec_trace) {
+        if (trace.format != TRACE_CONSOLE) {
+            if (trace_fichier == NULL) { afficher_usage_batch(argv[0]); libererProbleme(p); return EXIT_FAILURE; }
+            trace.flux = fopen(trace_fichier, trace.format == TRACE_BINAIRE ? "wb" : "w");
+            if (trace.flux == NULL) { perror("Erreur ouverture trace"); libererProbleme(p); return EXIT_FAILURE; }
+        }
+        options.trace = &trace;
+    }
+    if (nb_threads != 1) options.pool = creerPoolThreads(nb_threads);
+
+    if (!portfolio && fichier_cache) {
+        CacheSolutions* cache = creerCacheSolutions(TAILLE_CACHE_DEFAUT);
+        if (cache) {
+            chargerCacheSolutions(cache, fichier_cache); // Fichier absent : cache vide
+            ResultatCache origine;
+            options.resultat = &stats;
+            sol = resoudreAvecCache(p, cache, init, NULL, &options, &origine);
+            printf("Cache        : %s\n", origine == CACHE_EXACT ? "instance connue (aucun pivot)"
+                                      : origine == CACHE_VOISIN ? "base reprise (meme matrice A)" : "absent");
+            if (sol && !sauverCacheSolutions(cache, fichier_cache))
+                printf("/!\\ ERREUR : Ecriture du cache '%s' impossible\n", fichier_cache);
+            libererCacheSolutions(cache);
+        }
+        if (sol) afficher_arret(&stats, "");
+    } else if (!portfolio && decomposer) {
+        ResultatDecomposition bilan;
+        options.resultat = &stats;
+        sol = resoudreDecompose(p, init, seuil_interdit, &options, nb_threads, &bilan);
+        if (bilan.decompose)
+            printf("Decomposition: %d blocs (le plus grand : %d x %d), %d pivots en %.6f s\n", bilan.nb_blocs,
+                   bilan.plus_grand_n, bilan.plus_grand_m, bilan.pivots_blocs, bilan.duree_blocs);
+        else
+            printf("Decomposition: %s\n", bilan.nb_blocs > 1 ? "blocs desequilibres, resolution directe"
+                                                            : "un seul bloc, resolution directe");
+        if (sol) afficher_arret(&stats, " sur le probleme complet");
+    } else if (!portfolio && reduire) {
+        ResultatReduction bilan;
+        options.resultat = &stats;
+        sol = resoudreReduit(p, init, &options, &bilan);
+        if (bilan.reduit)
+            printf("Reduction    : %d x %d -> %d x %d (%d lignes / %d colonnes supprimees, %d / %d fusionnees, "
+                   "%d cases fixees), %d pivots en %.6f s\n", p->n, p->m, bilan.n_reduit, bilan.m_reduit,
+                   bilan.lignes_supprimees, bilan.colonnes_supprimees, bilan.lignes_fusionnees,
+                   bilan.colonnes_fusionnees, bilan.cases_fixees, bilan.pivots_reduit, bilan.duree_reduit);
+        else
+            printf("Reduction    : aucune, resolution directe\n");
+        if (sol) afficher_arret(&stats, " sur le probleme complet");
+    } else if (!portfolio) {
+        sol = resoudreAnytime(p, init, &options, &stats);
+        if (sol) {
+            printf("Initial (%s) : %.2f\n", abreviationMethodeInitiale(init), stats.cout_initial);
+            afficher_arret(&stats, "");
+        }
+    }
+    if (avec_trace && trace.flux != stdout) fclose(trace.flux);
+    libererPoolThreads(options.pool);
+    int code = EXIT_SUCCESS;
+    if (sol == NULL) {
+        printf("/!\\ ERREUR : Memoire insuffisante\n");
+        code = EXIT_FAILURE;
+    } else {
+        printf("Final (MP)   : %.2f (%d cases de base)\n", sol->cout_total, sol->nb_cases);
+        if (p->U && !solutionAdmissible(p)) {
+            printf("/!\\ ERREUR : Capacites insuffisantes, offre non entierement acheminee (irrealisable)\n");
+            code = EXIT_FAILURE;
+        }
+        if (csv && !exporterSolutionCSV(sol, csv)) code = EXIT_FAILURE;
+        if (json && !exporterSolutionJSON(sol, json)) code = EXIT_FAILURE;
+        if (bin && !exporterSolutionBinaire(sol, bin)) code = EXIT_FAILURE;
+        if (dual && !exporterDualeCSV(sol, dual)) {
+            printf("/!\\ ERREUR : Pas de certificat dual (optimalite non prouvee) ou ecriture impossible\n");
+            code = EXIT_FAILURE;
+        }
+        if (sensibilite) {
+            AnalyseSensibilite* analyse = analyserSensibilite(p, sol);
+            if (analyse) afficherAnalyseSensibilite(p, sol, analyse);
+            else {
+                printf("/!\\ ERREUR : Analyse impossible (%s)\n", p->U ? "probleme capacite" : "optimalite non prouvee");
+                code = EXIT_FAILURE;
+            }
+            libererAnalyseSensibilite(analyse);
+        }
+        if (verifier && (sol->E_s == NULL || sol->E_t == NULL)) {
+            printf("Certificat   : absent (optimalite non prouvee)\n");
+            code = EXIT_FAILURE;
+        } else if (verifier) {
+            RapportCertificat r;
+            bool ok = verifierCertificatOptimalite(p, sol, 1e-6, &r);
+            printf("Certificat   : %s (primal %s, dual %s, ecart %.3g)\n", ok ? "VALIDE" : "INVALIDE",
+                   r.admissible_primal ? "ok" : "KO", r.admissible_dual ? "ok" : "KO", r.ecart_dualite);
+            if (!ok) code = EXIT_FAILURE;
+        }
+    }
+
+    libererSolutionCreuse(sol);
+    libererProbleme(p);
+    return code;
 }
 
 // ==========================================================
@@ -208,12 +750,14 @@ void action_pipeline_nordouest(ProblemeTransport* p) {
 int main(int argc, char* argv[]) {
     afficher_banniere();
 
-    // MODE BATCH (Ligne de commande) - inchangé
+    // MODE BATCH (Ligne de commande)
     if (argc >= 2) {
-        // ... (Code batch identique à votre version précédente)
-        // Je l'omets ici pour la clarté, mais gardez votre bloc batch si nécessaire
-        printf("Mode Batch non disponible dans cet extrait simplifie.\n");
-        return 0;
+        if (strcmp(argv[1], "--help") == 0) { afficher_usage_batch(argv[0]); return EXIT_SUCCESS; }
+        if (strcmp(argv[1], "--etude") == 0) return executer_etude_batch(argc, argv);
+        if (strcmp(argv[1], "--reseau") == 0) return executer_reseau_batch(argc, argv);
+        if (strcmp(argv[1], "--demon") == 0) return executer_demon_batch(argc, argv);
+        if (strcmp(argv[1], "--client") == 0) return executer_client_batch(argc, argv);
+        return executer_mode_batch(argc, argv);
     }
 
     // MODE INTERACTIF
@@ -244,6 +788,7 @@ int main(int argc, char* argv[]) {
 
                 // Si un fichier a bien été chargé, on entre dans la boucle d'actions
                 if (p != NULL) {
+                    SolutionCreuse* derniere_solution = NULL;
                     int choix_action = -1;
                     while (choix_action != 0) {
                         afficher_menu_actions();
@@ -255,8 +800,29 @@ int main(int argc, char* argv[]) {
                         switch (choix_action) {
                             case 1: action_afficher_donnees(p); break;
                             case 2: action_comparer_initiaux(p); break;
-                            case 3: action_pipeline_balas(p); break;
-                            case 4: action_pipeline_nordouest(p); break;
+                            case 3:
+                                libererSolutionCreuse(derniere_solution);
+                                derniere_solution = action_pipeline(p, METHODE_BALAS_HAMMER);
+                                break;
+                            case 4:
+                                libererSolutionCreuse(derniere_solution);
+                                derniere_solution = action_pipeline(p, METHODE_NORD_OUEST);
+                                break;
+                            case 5: action_exporter_solution(derniere_solution); break;
+                            case 6:
+                                libererSolutionCreuse(derniere_solution);
+                                derniere_solution = action_pipeline(p, METHODE_RUSSELL);
+                                break;
+                            case 7:
+                                libererSolutionCreuse(derniere_solution);
+                                derniere_solution = action_pipeline(p, METHODE_MOINDRE_COUT);
+                                break;
+                            case 8: action_comparer_toutes_methodes(p); break;
+                            case 9:
+                                libererSolutionCreuse(derniere_solution);
+                                derniere_solution = action_portfolio(p);
+                                break;
+                            case 10: action_sensibilite(p, derniere_solution); break;
                             case 0:
                                 printf("\nFermeture du fichier.\n");
                                 break;
@@ -264,6 +830,7 @@ int main(int argc, char* argv[]) {
                         }
                     }
                     // Fin de la boucle d'actions : on libère la mémoire
+                    libererSolutionCreuse(derniere_solution);
                     libererProbleme(p);
                     p = NULL;
                 }
@@ -0,0 +1,196 @@
+/**
+ * @file memoire.c
+ * @brief Profil mémoire d'une exécution et pic de mémoire résidente du processus (/proc, Linux).
+ * Compilé avec -DPROFIL_MEMOIRE (glibc), malloc & co. sont remplacés par des versions qui comptent les
+ * allocations du thread profilé. Sans ce drapeau, l'allocateur n'est pas touché : le solde du tas vient
+ * de mallinfo2 et le pic de la mémoire résidente, pour tout le processus.
+ */
+
+#include "projet_ro.h"
+
+#if defined(__GLIBC__)
+#include <errno.h>
+#include <malloc.h>
+#endif
+
+#if defined(PROFIL_MEMOIRE) && defined(__GLIBC__)
+#define ALLOCATEUR_COMPTEUR 1
+#else
+#define ALLOCATEUR_COMPTEUR 0
+#endif
+
+// Compteurs du thread courant : un thread qui ne profile pas ne paie qu'un test par allocation
+static _Thread_local bool profil_actif = false;
+static _Thread_local ProfilMemoire profil;
+
+/**
+ * @brief Champ en ko de /proc/self/status (format sscanf, ex. "VmHWM: %ld kB"), 0 si indisponible.
+ */
+static long lireStatusKo(const char* format) {
+#ifdef __linux__
+    FILE* f = fopen("/proc/self/status", "r");
+    if (!f) return 0;
+    char ligne[256];
+    long ko = 0;
+    while (fgets(ligne, sizeof(ligne), f))
+        if (sscanf(ligne, format, &ko) == 1) break;
+    fclose(f);
+    return ko;
+#else
+    (void)format;
+    return 0;
+#endif
+}
+
+// ==========================================================
+// 1. ALLOCATEUR COMPTEUR (GLIBC, -DPROFIL_MEMOIRE)
+// ==========================================================
+
+#if ALLOCATEUR_COMPTEUR
+
+// Points d'entrée internes de la glibc : les fonctions ci-dessous remplacent malloc & co. pour tout le
+// programme (interposition de symboles) et leur délèguent l'allocation.
+extern void* __libc_malloc(size_t taille);
+extern void* __libc_calloc(size_t nb, size_t taille);
+extern void* __libc_realloc(void* ptr, size_t taille);
+extern void* __libc_memalign(size_t alignement, size_t taille);
+extern void* __libc_valloc(size_t taille);
+extern void __libc_free(void* ptr);
+
+static inline void compterAllocation(void* ptr, size_t taille) {
+    profil.nb_allocations++;
+    profil.octets_alloues += taille;
+    profil.octets_vivants += (long long)malloc_usable_size(ptr);
+    if (profil.octets_vivants > profil.pic_octets) profil.pic_octets = profil.octets_vivants;
+}
+
+void* malloc(size_t taille) {
+    void* ptr = __libc_malloc(taille);
+    if (profil_actif && ptr) compterAllocation(ptr, taille);
+    return ptr;
+}
+
+void* calloc(size_t nb, size_t taille) {
+    void* ptr = __libc_calloc(nb, taille); // nb * taille ne déborde pas si l'allocation a réussi
+    if (profil_actif && ptr) compterAllocation(ptr, nb * taille);
+    return ptr;
+}
+
+void* realloc(void* ptr, size_t taille) {
+    if (!profil_actif) return __libc_realloc(ptr, taille);
+    size_t ancienne = ptr ? malloc_usable_size(ptr) : 0;
+    void* nouveau = __libc_realloc(ptr, taille);
+    if (nouveau) {
+        profil.octets_vivants -= (long long)ancienne;
+        compterAllocation(nouveau, taille);
+    }
+    return nouveau;
+}
+
+// Variantes alignées : sans elles, leurs blocs seraient libérés par free sans avoir été comptés
+void* memalign(size_t alignement, size_t taille) {
+    void* ptr = __libc_memalign(alignement, taille);
+    if (profil_actif && ptr) compterAllocation(ptr, taille);
+    return ptr;
+}
+
+void* aligned_alloc(size_t alignement, size_t taille) {
+    return memalign(alignement, taille);
+}
+
+int posix_memalign(void** sortie, size_t alignement, size_t taille) {
+    if (alignement % sizeof(void*) != 0 || (alignement & (alignement - 1)) != 0) return EINVAL;
+    void* ptr = memalign(alignement, taille);
+    if (!ptr) return ENOMEM;
+    *sortie = ptr;
+    return 0;
+}
+
+void* valloc(size_t taille) {
+    void* ptr = __libc_valloc(taille);
+    if (profil_actif && ptr) compterAllocation(ptr, taille);
+    return ptr;
+}
+
+void free(void* ptr) {
+    // Un bloc alloué avant debuterProfilMemoire rend le solde négatif : seul le pic relatif compte
+    if (profil_actif && ptr) profil.octets_vivants -= (long long)malloc_usable_size(ptr);
+    __libc_free(ptr);
+}
+
+bool profilMemoireDisponible(void) {
+    return true;
+}
+
+void debuterProfilMemoire(void) {
+    memset(&profil, 0, sizeof(profil));
+    profil_actif = true;
+}
+
+ProfilMemoire terminerProfilMemoire(void) {
+    profil_actif = false;
+    return profil;
+}
+
+#else
+
+// ==========================================================
+// 1 BIS. ESTIMATION SANS INTERPOSITION
+// ==========================================================
+
+static _Thread_local long long tas_depart;  // Octets en usage dans le tas au début du profil
+static _Thread_local long resident_depart;  // Mémoire résidente (ko) au début du profil
+
+static long long tasUtilise(void) {
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    struct mallinfo2 mi = mallinfo2();
+    return (long long)(mi.uordblks + mi.hblkhd); // Blocs du tas + blocs servis par mmap
+#else
+    return 0;
+#endif
+}
+
+bool profilMemoireDisponible(void) {
+    return false; // Ni nombre d'allocations ni cumul alloué : seulement solde et pic estimés
+}
+
+void debuterProfilMemoire(void) {
+    memset(&profil, 0, sizeof(profil));
+    reinitialiserPicResident();
+    tas_depart = tasUtilise();
+    resident_depart = lireStatusKo("VmRSS: %ld kB");
+    profil_actif = true;
+}
+
+ProfilMemoire terminerProfilMemoire(void) {
+    profil_actif = false;
+    profil.octets_vivants = tasUtilise() - tas_depart;
+    // Pic : croissance de la mémoire résidente depuis le début (pages touchées, à la page près)
+    long pic = picResidentKo();
+    profil.pic_octets = (pic > resident_depart) ? (long long)(pic - resident_depart) * 1024 : 0;
+    if (profil.octets_vivants > profil.pic_octets) profil.pic_octets = profil.octets_vivants;
+    return profil;
+}
+
+#endif
+
+// ==========================================================
+// 2. MEMOIRE RESIDENTE DU PROCESSUS
+// ==========================================================
+
+void reinitialiserPicResident(void) {
+#if defined(__GLIBC__)
+    malloc_trim(0); // Rend au système le tas libre : le pic suivant ne profite pas des pages déjà touchées
+#endif
+#ifdef __linux__
+    // "5" remet VmHWM à la mémoire résidente courante (noyau >= 4.0)
+    FILE* f = fopen("/proc/self/clear_refs", "w");
+    if (!f) return;
+    fputs("5", f);
+    fclose(f);
+#endif
+}
+
+long picResidentKo(void) {
+    return lireStatusKo("VmHWM: %ld kB");
+}
@@ -0,0 +1,625 @@
+/**
+ * @file parallele.c
+ * @brief Pool de threads persistant et calcul parallèle des coûts marginaux.
+ * Les threads sont créés une seule fois et réveillés à chaque lot de tâches (pas de création par pivot).
+ * Contient aussi la résolution en portefeuille (un thread par pipeline, annulation coopérative).
+ */
+
+#include "projet_ro.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <unistd.h>
+
+// Seuil de tolérance pour les comparaisons flottantes (identique à projet_ro.c)
+#define EPSILON 1e-9
+
+// En dessous de ce nombre de cases, le calcul séquentiel est plus rapide que la synchronisation
+#define SEUIL_PRICING_PARALLELE 4096
+
+// ==========================================================
+// 1. POOL DE THREADS
+// ==========================================================
+
+struct PoolThreads {
+    int nb_threads;          // Threads de calcul, appelant compris
+    pthread_t* threads;      // Threads auxiliaires (nb_threads - 1)
+    pthread_mutex_t lot;     // Tenu pendant tout executerEnParallele : un appelant à la fois par pool
+    pthread_mutex_t verrou;
+    pthread_cond_t reveil;   // Signale un nouveau lot (ou l'arrêt)
+    pthread_cond_t termine;  // Signale la fin du lot courant
+
+    // Lot courant (modifié sous verrou, uniquement quand aucun thread n'est actif)
+    TacheParallele fonction;
+    void* contexte;
+    int nb_taches;
+    atomic_int prochaine;    // Prochaine tâche à distribuer
+    int restantes;           // Tâches non terminées (protégé par verrou)
+    int actifs;              // Threads auxiliaires engagés dans le lot (protégé par verrou)
+    unsigned long generation;
+    bool arret;
+};
+
+/**
+ * @brief Exécute les tâches d'un lot jusqu'à épuisement et renvoie le nombre de tâches faites.
+ */
+static int traiterTaches(PoolThreads* pool, TacheParallele fonction, void* contexte, int nb_taches) {
+    int faites = 0;
+    for (;;) {
+        int k = atomic_fetch_add(&pool->prochaine, 1);
+        if (k >= nb_taches) break;
+        fonction(contexte, k, nb_taches);
+        faites++;
+    }
+    return faites;
+}
+
+static void* boucleThread(void* arg) {
+    PoolThreads* pool = (PoolThreads*)arg;
+    unsigned long vue = 0;
+    pthread_mutex_lock(&pool->verrou);
+    for (;;) {
+        while (!pool->arret && pool->generation == vue) pthread_cond_wait(&pool->reveil, &pool->verrou);
+        if (pool->arret) break;
+        vue = pool->generation;
+        // Copie du lot sous verrou : il ne peut pas changer tant que actifs > 0
+        TacheParallele fonction = pool->fonction;
+        void* contexte = pool->contexte;
+        int nb_taches = pool->nb_taches;
+        pool->actifs++;
+        pthread_mutex_unlock(&pool->verrou);
+
+        int faites = traiterTaches(pool, fonction, contexte, nb_taches);
+
+        pthread_mutex_lock(&pool->verrou);
+        pool->restantes -= faites;
+        pool->actifs--;
+        if (pool->restantes == 0 && pool->actifs == 0) pthread_cond_broadcast(&pool->termine);
+    }
+    pthread_mutex_unlock(&pool->verrou);
+    return NULL;
+}
+
+int nbCoeursDisponibles(void) {
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return (n > 0) ? (int)n : 1;
+}
+
+PoolThreads* creerPoolThreads(int nb_threads) {
+    if (nb_threads <= 0) nb_threads = nbCoeursDisponibles();
+    PoolThreads* pool = (PoolThreads*)calloc(1, sizeof(PoolThreads));
+    if (!pool) return NULL;
+    pool->nb_threads = nb_threads;
+    pool->threads = (pthread_t*)malloc((nb_threads > 1 ? nb_threads - 1 : 1) * sizeof(pthread_t));
+    if (!pool->threads) { free(pool); return NULL; }
+    pthread_mutex_init(&pool->lot, NULL);
+    pthread_mutex_init(&pool->verrou, NULL);
+    pthread_cond_init(&pool->reveil, NULL);
+    pthread_cond_init(&pool->termine, NULL);
+    atomic_init(&pool->prochaine, 0);
+
+    for (int k = 0; k < nb_threads - 1; k++) {
+        if (pthread_create(&pool->threads[k], NULL, boucleThread, pool) != 0) {
+            // Pool réduit aux threads effectivement créés
+            pool->nb_threads = k + 1;
+            break;
+        }
+    }
+    return pool;
+}
+
+void libererPoolThreads(PoolThreads* pool) {
+    if (!pool) return;
+    pthread_mutex_lock(&pool->verrou);
+    pool->arret = true;
+    pthread_cond_broadcast(&pool->reveil);
+    pthread_mutex_unlock(&pool->verrou);
+    for (int k = 0; k < pool->nb_threads - 1; k++) pthread_join(pool->threads[k], NULL);
+    pthread_mutex_destroy(&pool->lot);
+    pthread_mutex_destroy(&pool->verrou);
+    pthread_cond_destroy(&pool->reveil);
+    pthread_cond_destroy(&pool->termine);
+    free(pool->threads);
+    free(pool);
+}
+
+int nbThreadsPool(const PoolThreads* pool) {
+    return pool ? pool->nb_threads : 1;
+}
+
+void executerEnParallele(PoolThreads* pool, int nb_taches, TacheParallele fonction, void* contexte) {
+    if (nb_taches <= 0) return;
+    if (!pool || pool->nb_threads == 1 || nb_taches == 1) {
+        for (int k = 0; k < nb_taches; k++) fonction(contexte, k, nb_taches);
+        return;
+    }
+
+    // Des poignées partageant le pool l'appellent depuis des threads différents : les lots se suivent
+    pthread_mutex_lock(&pool->lot);
+    pthread_mutex_lock(&pool->verrou);
+    // Un thread réveillé en retard pour le lot précédent doit en être sorti
+    while (pool->actifs > 0) pthread_cond_wait(&pool->termine, &pool->verrou);
+    pool->fonction = fonction;
+    pool->contexte = contexte;
+    pool->nb_taches = nb_taches;
+    pool->restantes = nb_taches;
+    atomic_store(&pool->prochaine, 0);
+    pool->generation++;
+    pthread_cond_broadcast(&pool->reveil);
+    pthread_mutex_unlock(&pool->verrou);
+
+    // L'appelant participe au calcul
+    int faites = traiterTaches(pool, fonction, contexte, nb_taches);
+
+    pthread_mutex_lock(&pool->verrou);
+    pool->restantes -= faites;
+    while (pool->restantes > 0 || pool->actifs > 0) pthread_cond_wait(&pool->termine, &pool->verrou);
+    pthread_mutex_unlock(&pool->verrou);
+    pthread_mutex_unlock(&pool->lot);
+}
+
+// ==========================================================
+// 2. COUTS MARGINAUX EN PARALLELE
+// ==========================================================
+
+// Meilleur candidat d'un bloc de lignes
+typedef struct {
+    double gain;
+    int i, j;
+} CandidatBloc;
+
+typedef struct {
+    ProblemeTransport* p;
+    BaseBinaire* base;
+    double* E_s;
+    double* E_t;
+    double** couts_marginaux;
+    CandidatBloc* candidats; // Un par bloc
+} ContextePricing;
+
+/**
+ * @brief Calcule les coûts marginaux d'un bloc de lignes contiguës.
+ * Parcours lexicographique avec comparaison stricte : le premier minimum du bloc est retenu.
+ */
+static void pricingBloc(void* ctx, int k, int nb_blocs) {
+    ContextePricing* c = (ContextePricing*)ctx;
+    ProblemeTransport* p = c->p;
+    int debut = (int)((long)p->n * k / nb_blocs);
+    int fin = (int)((long)p->n * (k + 1) / nb_blocs);
+    CandidatBloc meilleur = { -EPSILON, -1, -1 };
+
+    for (int i = debut; i < fin; i++) {
+        const double* A_i = p->A[i];
+        double* cm_i = c->couts_marginaux[i];
+        double es = c->E_s[i];
+        for (int j = 0; j < p->m; j++) {
+            if (estDeBase(c->base, i, j)) {
+                cm_i[j] = 0.0;
+            } else {
+                double delta = A_i[j] - (es - c->E_t[j]);
+                cm_i[j] = delta;
+                if (delta < meilleur.gain) { meilleur.gain = delta; meilleur.i = i; meilleur.j = j; }
+            }
+        }
+    }
+    c->candidats[k] = meilleur;
+}
+
+bool calculerCoutsMarginauxParallele(ProblemeTransport* p, BaseBinaire* base, double* E_s, double* E_t,
+                                     int* i_ajout, int* j_ajout, double** couts_marginaux,
+                                     PoolThreads* pool) {
+    // Problème capacité : règle de prix propre aux cases pleines, traitée séquentiellement
+    if (!pool || pool->nb_threads == 1 || (long)p->n * p->m < SEUIL_PRICING_PARALLELE || p->n < 2 || p->U)
+        return calculerCoutsMarginaux(p, base, E_s, E_t, i_ajout, j_ajout, couts_marginaux);
+
+    // Quelques blocs par thread pour équilibrer la charge
+    int nb_blocs = 4 * pool->nb_threads;
+    if (nb_blocs > p->n) nb_blocs = p->n;
+    CandidatBloc* candidats = (CandidatBloc*)malloc(nb_blocs * sizeof(CandidatBloc));
+    if (!candidats) return calculerCoutsMarginaux(p, base, E_s, E_t, i_ajout, j_ajout, couts_marginaux);
+
+    ContextePricing ctx = { p, base, E_s, E_t, couts_marginaux, candidats };
+    executerEnParallele(pool, nb_blocs, pricingBloc, &ctx);
+
+    // Réduction dans l'ordre des blocs : même choix que le parcours séquentiel
+    double meilleur_gain = -EPSILON;
+    *i_ajout = -1; *j_ajout = -1;
+    for (int k = 0; k < nb_blocs; k++) {
+        if (candidats[k].i != -1 && candidats[k].gain < meilleur_gain) {
+            meilleur_gain = candidats[k].gain;
+            *i_ajout = candidats[k].i;
+            *j_ajout = candidats[k].j;
+        }
+    }
+    free(candidats);
+    return *i_ajout != -1;
+}
+
+// ==========================================================
+// 3. PORTEFEUILLE (PIPELINES EN CONCURRENCE)
+// ==========================================================
+
+// État partagé par les pipelines d'une même course
+typedef struct {
+    atomic_bool annulation; // Levé par le gagnant : les autres s'arrêtent au pivot suivant
+    atomic_int gagnant;     // Indice du premier pipeline optimal (-1 tant qu'aucun)
+} CoursePortfolio;
+
+typedef struct {
+    int indice;
+    MethodeInitiale methode;
+    ProblemeTransport* vue;      // B privée, A/P/C partagés
+    OptionsMarchePied options;   // Copie privée (resultat et annulation renseignés)
+    ResultatMarchePied stats;
+    SolutionCreuse* solution;
+    CoursePortfolio* course;
+} PipelinePortfolio;
+
+static void* executerPipeline(void* arg) {
+    PipelinePortfolio* pl = (PipelinePortfolio*)arg;
+    appliquerMethodeInitiale(pl->vue, pl->methode, false);
+    pl->solution = algoMarchePiedOptions(pl->vue, &pl->options);
+    if (pl->solution && pl->stats.optimal) {
+        int attendu = -1;
+        if (atomic_compare_exchange_strong(&pl->course->gagnant, &attendu, pl->indice))
+            atomic_store(&pl->course->annulation, true);
+    }
+    return NULL;
+}
+
+SolutionCreuse* resoudrePortfolio(ProblemeTransport* p, const MethodeInitiale* methodes, int nb_methodes,
+                                  const OptionsMarchePied* options, ResultatPortfolio* resultat) {
+    if (!p || !methodes || nb_methodes <= 0) return NULL;
+    double debut = horlogeMurale();
+    // Ordres triés calculés une fois dans le cache de p, partagés par les vues de toutes les méthodes
+    ordresCouts(p, true);
+
+    CoursePortfolio course;
+    atomic_init(&course.annulation, false);
+    atomic_init(&course.gagnant, -1);
+
+    PipelinePortfolio* pipelines = (PipelinePortfolio*)calloc(nb_methodes, sizeof(PipelinePortfolio));
+    pthread_t* threads = (pthread_t*)malloc(nb_methodes * sizeof(pthread_t));
+    bool* lances = (bool*)calloc(nb_methodes, sizeof(bool));
+    if (!pipelines || !threads || !lances) { free(pipelines); free(threads); free(lances); return NULL; }
+
+    for (int k = 0; k < nb_methodes; k++) {
+        PipelinePortfolio* pl = &pipelines[k];
+        pl->indice = k;
+        pl->methode = methodes[k];
+        pl->course = &course;
+        pl->vue = creerProblemePartage(p);
+        if (options) pl->options = *options;
+        else optionsMarchePiedParDefaut(&pl->options);
+        // Le pool n'accepte qu'un lot à la fois et la trace n'est pas partageable entre threads
+        pl->options.trace = NULL;
+        pl->options.pool = NULL;
+        pl->options.resultat = &pl->stats;
+        pl->options.annulation = &course.annulation;
+    }
+
+    for (int k = 0; k < nb_methodes; k++) {
+        if (pipelines[k].vue && pthread_create(&threads[k], NULL, executerPipeline, &pipelines[k]) == 0)
+            lances[k] = true;
+    }
+    // Pipelines sans thread (échec de création) : exécutés par l'appelant
+    for (int k = 0; k < nb_methodes; k++)
+        if (pipelines[k].vue && !lances[k]) executerPipeline(&pipelines[k]);
+    for (int k = 0; k < nb_methodes; k++)
+        if (lances[k]) pthread_join(threads[k], NULL);
+
+    // Le premier optimal gagne ; à défaut, le plus petit coût parmi les pipelines terminés
+    int retenu = atomic_load(&course.gagnant);
+    if (retenu < 0) {
+        for (int k = 0; k < nb_methodes; k++) {
+            if (!pipelines[k].solution) continue;
+            if (retenu < 0 || pipelines[k].solution->cout_total < pipelines[retenu].solution->cout_total)
+                retenu = k;
+        }
+    }
+
+    SolutionCreuse* solution = NULL;
+    if (retenu >= 0) {
+        solution = pipelines[retenu].solution;
+        pipelines[retenu].solution = NULL;
+        appliquerSolutionCreuse(p, solution);
+        if (resultat) {
+            resultat->gagnante = pipelines[retenu].methode;
+            resultat->optimal = pipelines[retenu].stats.optimal;
+            resultat->pivots = pipelines[retenu].stats.pivots;
+            resultat->cout_total = solution->cout_total;
+            resultat->duree = horlogeMurale() - debut;
+        }
+    }
+
+    for (int k = 0; k < nb_methodes; k++) {
+        libererSolutionCreuse(pipelines[k].solution);
+        libererProblemePartage(pipelines[k].vue);
+    }
+    free(pipelines); free(threads); free(lances);
+    return solution;
+}
+
+// ==========================================================
+// 4. MULTI-PRODUITS (MATRICE DE COUTS PARTAGEE)
+// ==========================================================
+
+typedef struct {
+    const ProblemeTransport* p;  // A, U et ordres partagés en lecture seule
+    ProduitTransport* produits;
+    int nb_produits;
+    MethodeInitiale methode;
+    OptionsMarchePied options;   // Copie commune (trace, pool et resultat neutralisés)
+    atomic_bool erreur;
+} ContexteMultiProduits;
+
+/**
+ * @brief Résout un bloc contigu de produits sur une vue privée (B propre, P/C du produit).
+ * Chaque produit repart de la base du précédent tant qu'elle reste admissible.
+ */
+static void resoudreBlocProduits(void* ctx, int k, int nb_blocs) {
+    ContexteMultiProduits* c = (ContexteMultiProduits*)ctx;
+    int debut = (int)((long)c->nb_produits * k / nb_blocs);
+    int fin = (int)((long)c->nb_produits * (k + 1) / nb_blocs);
+    ProblemeTransport* vue = creerProblemePartage(c->p);
+    if (!vue) { atomic_store(&c->erreur, true); return; }
+
+    const SolutionCreuse* voisine = NULL;
+    for (int q = debut; q < fin; q++) {
+        ProduitTransport* pr = &c->produits[q];
+        vue->P = pr->P;
+        vue->C = pr->C;
+        pr->demarrage_chaud = voisine && appliquerBaseVoisine(vue, voisine);
+        if (!pr->demarrage_chaud) appliquerMethodeInitiale(vue, c->methode, false);
+
+        OptionsMarchePied o = c->options;
+        o.resultat = &pr->stats;
+        pr->solution = algoMarchePiedOptions(vue, &o);
+        if (!pr->solution) atomic_store(&c->erreur, true);
+        voisine = pr->solution;
+    }
+    libererProblemePartage(vue);
+}
+
+bool resoudreMultiProduits(const ProblemeTransport* p, ProduitTransport* produits, int nb_produits,
+                           MethodeInitiale methode, const OptionsMarchePied* options, int nb_threads) {
+    if (!p || !produits || nb_produits <= 0) return false;
+
+    ContexteMultiProduits ctx;
+    ctx.p = p;
+    ctx.produits = produits;
+    ctx.nb_produits = nb_produits;
+    ctx.methode = methode;
+    if (options) ctx.options = *options;
+    else optionsMarchePiedParDefaut(&ctx.options);
+    ctx.options.trace = NULL;
+    ctx.options.pool = NULL;
+    ctx.options.resultat = NULL;
+    atomic_init(&ctx.erreur, false);
+    for (int q = 0; q < nb_produits; q++) { produits[q].solution = NULL; produits[q].demarrage_chaud = false; }
+
+    // Ordres triés de A calculés une fois pour tous les produits, sauf si le cache de p convient déjà
+    ProblemeTransport partage = *p;
+    partage.ordres_possedes = false;
+    OrdresCouts* ordres = NULL;
+    bool avec_global = (methode == METHODE_MOINDRE_COUT);
+    if (methode != METHODE_NORD_OUEST && (!p->ordres || (avec_global && !p->ordres->global)))
+        partage.ordres = ordres = calculerOrdresCouts(p, avec_global);
+    ctx.p = &partage;
+
+    PoolThreads* pool = creerPoolThreads(nb_threads);
+    int nb_blocs = pool ? pool->nb_threads : 1;
+    if (nb_blocs > nb_produits) nb_blocs = nb_produits;
+    executerEnParallele(pool, nb_blocs, resoudreBlocProduits, &ctx);
+    libererPoolThreads(pool);
+    libererOrdresCouts(ordres);
+    return !atomic_load(&ctx.erreur);
+}
+
+// ==========================================================
+// 5. DECOMPOSITION EN BLOCS INDEPENDANTS
+// ==========================================================
+
+typedef struct {
+    ProblemeTransport* sous;   // Sous-problème du bloc (NULL : bloc sans case, rien à acheminer)
+    int* lignes;               // Indices d'origine des fournisseurs du bloc
+    int* colonnes;             // Indices d'origine des clients du bloc
+    long taille;               // Nombre de cases du bloc (ordre de résolution)
+    ResultatMarchePied stats;
+} BlocIndependant;
+
+typedef struct {
+    BlocIndependant* blocs;
+    MethodeInitiale methode;
+    OptionsMarchePied options; // Copie commune (trace, pool et resultat neutralisés)
+    atomic_bool erreur;
+} ContexteDecomposition;
+
+static int racineComposante(int* parent, int x) {
+    while (parent[x] != x) {
+        parent[x] = parent[parent[x]]; // Compression par moitiés
+        x = parent[x];
+    }
+    return x;
+}
+
+/**
+ * @brief Étiquette les composantes du graphe des liaisons ouvertes : composante[u] dans [0, nb[,
+ * u < n pour les fournisseurs, n + j pour les clients. @return Le nombre de composantes, -1 en cas d'erreur.
+ */
+static int etiqueterComposantes(const ProblemeTransport* p, double seuil_interdit, int* composante) {
+    int n = p->n, m = p->m;
+    int* parent = (int*)malloc((n + m) * sizeof(int));
+    if (!parent) return -1;
+    for (int u = 0; u < n + m; u++) parent[u] = u;
+
+    for (int i = 0; i < n; i++) {
+        const double* ligne = p->A[i];
+        // Cases plafonnées de la ligne, colonnes croissantes : parcourues en même temps que la ligne
+        int k = p->U ? p->U->debut[i] : 0, fin = p->U ? p->U->debut[i + 1] : 0;
+        int racine_i = racineComposante(parent, i);
+        for (int j = 0; j < m; j++) {
+            while (k < fin && p->U->colonne[k] < j) k++;
+            if (ligne[j] >= seuil_interdit || (k < fin && p->U->colonne[k] == j && p->U->capacite[k] == 0)) continue;
+            int racine_j = racineComposante(parent, n + j);
+            if (racine_j != racine_i) {
+                parent[racine_j] = racine_i;
+            }
+        }
+    }
+
+    int nb = 0;
+    for (int u = 0; u < n + m; u++) composante[u] = -1;
+    for (int u = 0; u < n + m; u++) {
+        int r = racineComposante(parent, u);
+        if (composante[r] < 0) composante[r] = nb++;
+        composante[u] = composante[r];
+    }
+    free(parent);
+    return nb;
+}
+
+/**
+ * @brief Construit le sous-problème d'un bloc (A, P, C et capacités restreints à ses lignes et colonnes).
+ */
+static bool construireBloc(const ProblemeTransport* p, const int* composante, int c, BlocIndependant* b,
+                           int nb_lignes, int nb_colonnes) {
+    int n = p->n;
+    b->lignes = (int*)malloc(nb_lignes * sizeof(int));
+    b->colonnes = (int*)malloc(nb_colonnes * sizeof(int));
+    b->sous = creerProbleme(nb_lignes, nb_colonnes);
+    if (!b->lignes || !b->colonnes || !b->sous) return false;
+    b->taille = (long)nb_lignes * nb_colonnes;
+
+    int a = 0, e = 0;
+    for (int i = 0; i < n; i++) if (composante[i] == c) b->lignes[a++] = i;
+    for (int j = 0; j < p->m; j++) if (composante[n + j] == c) b->colonnes[e++] = j;
+    for (int x = 0; x < nb_lignes; x++) {
+        const double* ligne = p->A[b->lignes[x]];
+        for (int y = 0; y < nb_colonnes; y++) b->sous->A[x][y] = ligne[b->colonnes[y]];
+        b->sous->P[x] = p->P[b->lignes[x]];
+    }
+    for (int y = 0; y < nb_colonnes; y++) b->sous->C[y] = p->C[b->colonnes[y]];
+
+    if (p->U) {
+        // Indice local des colonnes du bloc (-1 : hors bloc) pour filtrer les cases plafonnées
+        int* locale = (int*)malloc(p->m * sizeof(int));
+        int* li = (int*)malloc((p->U->nb + 1) * sizeof(int));
+        int* co = (int*)malloc((p->U->nb + 1) * sizeof(int));
+        int* ca = (int*)malloc((p->U->nb + 1) * sizeof(int));
+        bool ok = locale && li && co && ca;
+        int nb = 0;
+        if (ok) {
+            for (int j = 0; j < p->m; j++) locale[j] = -1;
+            for (int y = 0; y < nb_colonnes; y++) locale[b->colonnes[y]] = y;
+            for (int x = 0; x < nb_lignes; x++) {
+                int i = b->lignes[x];
+                for (int k = p->U->debut[i]; k < p->U->debut[i + 1]; k++) {
+                    if (locale[p->U->colonne[k]] < 0) continue;
+                    li[nb] = x; co[nb] = locale[p->U->colonne[k]]; ca[nb++] = p->U->capacite[k];
+                }
+            }
+            ok = definirCapacites(b->sous, nb, li, co, ca);
+        }
+        free(locale); free(li); free(co); free(ca);
+        if (!ok) return false;
+    }
+    return actualiserCouts(b->sous);
+}
+
+static int comparerBlocs(const void* x, const void* y) {
+    long a = ((const BlocIndependant*)x)->taille, b = ((const BlocIndependant*)y)->taille;
+    return (a < b) - (a > b); // Décroissant : les plus grands blocs partent en premier
+}
+
+static void resoudreBloc(void* ctx, int k, int nb_blocs) {
+    (void)nb_blocs;
+    ContexteDecomposition* c = (ContexteDecomposition*)ctx;
+    BlocIndependant* b = &c->blocs[k];
+    if (!b->sous) return;
+    OptionsMarchePied o = c->options;
+    SolutionCreuse* sol = resoudreAnytime(b->sous, c->methode, &o, &b->stats);
+    if (!sol) atomic_store(&c->erreur, true);
+    libererSolutionCreuse(sol); // La solution reste dans b->sous->B
+}
+
+SolutionCreuse* resoudreDecompose(ProblemeTransport* p, MethodeInitiale methode, double seuil_interdit,
+                                  const OptionsMarchePied* options, int nb_threads, ResultatDecomposition* bilan) {
+    int n = p->n, m = p->m;
+    OptionsMarchePied finale;
+    if (options) finale = *options;
+    else optionsMarchePiedParDefaut(&finale);
+    ResultatDecomposition local;
+    if (!bilan) bilan = &local;
+    memset(bilan, 0, sizeof(*bilan));
+    bilan->nb_blocs = 1;
+
+    int* composante = (int*)malloc((n + m) * sizeof(int));
+    int nb = composante ? etiqueterComposantes(p, seuil_interdit, composante) : -1;
+    int* nb_lignes = (nb > 1) ? (int*)calloc(nb, sizeof(int)) : NULL;
+    int* nb_colonnes = (nb > 1) ? (int*)calloc(nb, sizeof(int)) : NULL;
+    long* solde = (nb > 1) ? (long*)calloc(nb, sizeof(long)) : NULL;
+    bool decomposable = nb_lignes && nb_colonnes && solde;
+    if (decomposable) {
+        bilan->nb_blocs = nb;
+        for (int i = 0; i < n; i++) { nb_lignes[composante[i]]++; solde[composante[i]] += p->P[i]; }
+        for (int j = 0; j < m; j++) { nb_colonnes[composante[n + j]]++; solde[composante[n + j]] -= p->C[j]; }
+        // Un bloc déséquilibré devrait emprunter une liaison fermée : pas de décomposition
+        for (int c = 0; c < nb; c++) decomposable = decomposable && solde[c] == 0;
+    }
+
+    BlocIndependant* blocs = decomposable ? (BlocIndependant*)calloc(nb, sizeof(BlocIndependant)) : NULL;
+    bool ok = blocs != NULL;
+    for (int c = 0; ok && c < nb; c++)
+        if (nb_lignes[c] > 0 && nb_colonnes[c] > 0)
+            ok = construireBloc(p, composante, c, &blocs[c], nb_lignes[c], nb_colonnes[c]);
+    free(nb_lignes); free(nb_colonnes); free(solde); free(composante);
+
+    if (ok) {
+        double debut = horlogeMurale();
+        qsort(blocs, nb, sizeof(BlocIndependant), comparerBlocs);
+        ContexteDecomposition ctx;
+        ctx.blocs = blocs;
+        ctx.methode = methode;
+        ctx.options = finale;
+        ctx.options.trace = NULL;
+        ctx.options.pool = NULL;
+        ctx.options.resultat = NULL;
+        atomic_init(&ctx.erreur, false);
+        PoolThreads* pool = creerPoolThreads(nb_threads);
+        executerEnParallele(pool, nb, resoudreBloc, &ctx);
+        libererPoolThreads(pool);
+        ok = !atomic_load(&ctx.erreur);
+
+        // Recollage des blocs dans B
+        reinitialiserSolution(p);
+        for (int c = 0; ok && c < nb; c++) {
+            BlocIndependant* b = &blocs[c];
+            if (!b->sous) continue;
+            for (int x = 0; x < b->sous->n; x++)
+                for (int y = 0; y < b->sous->m; y++)
+                    p->B[b->lignes[x]][b->colonnes[y]] = b->sous->B[x][y];
+            bilan->pivots_blocs += b->stats.pivots;
+        }
+        bilan->duree_blocs = horlogeMurale() - debut;
+        bilan->decompose = ok;
+        if (blocs[0].sous) { bilan->plus_grand_n = blocs[0].sous->n; bilan->plus_grand_m = blocs[0].sous->m; }
+    }
+    for (int c = 0; blocs && c < nb; c++) {
+        libererProbleme(blocs[c].sous);
+        free(blocs[c].lignes);
+        free(blocs[c].colonnes);
+    }
+    free(blocs);
+
+    if (!bilan->decompose) {
+        bilan->plus_grand_n = n;
+        bilan->plus_grand_m = m;
+        return resoudreAnytime(p, methode, &finale, finale.resultat);
+    }
+    // Passe finale sur le problème complet : certificat d'optimalité (ou correction) depuis les blocs recollés
+    if (finale.delai_max > 0.0) {
+        double restant = finale.delai_max - bilan->duree_blocs;
+        finale.delai_max = (restant > 1e-9) ? restant : 1e-9;
+    }
+    return algoMarchePiedOptions(p, &finale);
+}
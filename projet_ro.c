@@ -6,6 +6,8 @@
 
 #include "projet_ro.h"
 #include <math.h>
+#include <assert.h>
+#include <time.h>
 
 // Seuil de tolérance pour les comparaisons flottantes
 #define EPSILON 1e-9
@@ -16,8 +18,9 @@
 
 Queue* creerQueue(int capacity) {
     Queue* q = (Queue*)malloc(sizeof(Queue));
-    if (!q) { perror("Erreur alloc queue"); exit(EXIT_FAILURE); }
+    if (!q) return NULL;
     q->data = (BFSNode*)malloc(capacity * sizeof(BFSNode));
+    if (!q->data) { free(q); return NULL; }
     q->front = 0;
     q->rear = -1;
     q->capacity = capacity;
@@ -32,6 +35,12 @@ bool isQueueEmpty(Queue* q) {
     return q->rear < q->front;
 }
 
+double horlogeMurale(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
 void enqueue(Queue* q, int index, int parent) {
     if (q->rear < q->capacity - 1) {
         q->rear++;
@@ -49,37 +58,129 @@ BFSNode dequeue(Queue* q) {
     return node;
 }
 
+BaseBinaire* creerBaseBinaire(int n, int m) {
+    BaseBinaire* b = (BaseBinaire*)malloc(sizeof(BaseBinaire));
+    if (!b) return NULL;
+    b->n = n; b->m = m;
+    b->mots_lig = (m + 63) / 64;
+    b->mots_col = (n + 63) / 64;
+    b->lignes = (uint64_t*)calloc((size_t)n * b->mots_lig, sizeof(uint64_t));
+    b->colonnes = (uint64_t*)calloc((size_t)m * b->mots_col, sizeof(uint64_t));
+    b->file = creerQueue(n + m);
+    b->vus_lig = (uint64_t*)malloc(b->mots_col * sizeof(uint64_t));
+    b->vus_col = (uint64_t*)malloc(b->mots_lig * sizeof(uint64_t));
+    b->parent = (int*)malloc((n + m) * sizeof(int));
+    if (!b->lignes || !b->colonnes || !b->file || !b->vus_lig || !b->vus_col || !b->parent) {
+        libererBaseBinaire(b);
+        return NULL;
+    }
+    return b;
+}
+
+void libererBaseBinaire(BaseBinaire* b) {
+    if (!b) return;
+    free(b->lignes); free(b->colonnes);
+    libererQueue(b->file); free(b->vus_lig); free(b->vus_col); free(b->parent);
+    free(b);
+}
+
+int compterCasesBase(const BaseBinaire* b) {
+    int nb = 0;
+    for (long w = 0; w < (long)b->n * b->mots_lig; w++) nb += compterBits(b->lignes[w]);
+    return nb;
+}
+
 /**
- * @brief Vérifie l'existence d'un chemin dans le graphe partiel de la base.
+ * @brief Démarre un parcours depuis le sommet depart (ligne si < n, colonne depart - n sinon) dans
+ * l'espace de la base : file vidée, aucun sommet vu hors départ.
  */
-static bool cheminExiste(int n, int m, int** base, int start, int target) {
-    Queue* q = creerQueue(n + m);
-    bool* visite = (bool*)calloc(n + m, sizeof(bool));
-    bool found = false;
+static void debuterParcours(BaseBinaire* b, int depart) {
+    b->file->front = 0;
+    b->file->rear = -1;
+    memset(b->vus_lig, 0, b->mots_col * sizeof(uint64_t));
+    memset(b->vus_col, 0, b->mots_lig * sizeof(uint64_t));
+    if (depart < b->n) b->vus_lig[depart >> 6] |= (uint64_t)1 << (depart & 63);
+    else b->vus_col[(depart - b->n) >> 6] |= (uint64_t)1 << ((depart - b->n) & 63);
+    enqueue(b->file, depart, -1);
+}
 
-    enqueue(q, start, -1);
-    visite[start] = true;
+/**
+ * @brief Enfile les voisins non vus du sommet u (ligne si u < n, colonne u - n sinon) et les marque vus.
+ * Un mot de voisins est filtré d'un coup (ET-NON avec les sommets vus), puis parcouru par bit de poids
+ * faible. Ordre d'enfilage : indices croissants, comme un balayage case par case.
+ */
+static void enfilerVoisinsNonVus(BaseBinaire* b, int u) {
+    int n = b->n;
+    if (u < n) {
+        const uint64_t* ligne = b->lignes + (long)u * b->mots_lig;
+        for (int w = 0; w < b->mots_lig; w++) {
+            uint64_t nouveaux = ligne[w] & ~b->vus_col[w];
+            b->vus_col[w] |= nouveaux;
+            for (; nouveaux; nouveaux &= nouveaux - 1)
+                enqueue(b->file, n + (w << 6) + bitPoidsFaible(nouveaux), u);
+        }
+    } else {
+        const uint64_t* colonne = b->colonnes + (long)(u - n) * b->mots_col;
+        for (int w = 0; w < b->mots_col; w++) {
+            uint64_t nouveaux = colonne[w] & ~b->vus_lig[w];
+            b->vus_lig[w] |= nouveaux;
+            for (; nouveaux; nouveaux &= nouveaux - 1)
+                enqueue(b->file, (w << 6) + bitPoidsFaible(nouveaux), u);
+        }
+    }
+}
 
-    while (!isQueueEmpty(q)) {
-        int u = dequeue(q).index;
-        if (u == target) { found = true; break; }
+/**
+ * @brief true si le sommet u (ligne si u < n, colonne u - n sinon) a été atteint par le dernier parcours.
+ */
+static bool sommetVu(const BaseBinaire* b, int u) {
+    if (u < b->n) return (b->vus_lig[u >> 6] >> (u & 63)) & 1u;
+    u -= b->n;
+    return (b->vus_col[u >> 6] >> (u & 63)) & 1u;
+}
 
-        if (u < n) {
-            for (int j = 0; j < m; j++) {
-                if (base[u][j] && !visite[n + j]) {
-                    visite[n + j] = true; enqueue(q, n + j, u);
-                }
-            }
-        } else {
-            for (int i = 0; i < n; i++) {
-                if (base[i][u - n] && !visite[i]) {
-                    visite[i] = true; enqueue(q, i, u);
-                }
+/**
+ * @brief Vérifie l'existence d'un chemin dans le graphe partiel de la base.
+ */
+static bool cheminExiste(BaseBinaire* base, int start, int target) {
+    debuterParcours(base, start);
+    while (!isQueueEmpty(base->file)) {
+        int u = dequeue(base->file).index;
+        if (u == target) return true;
+        enfilerVoisinsNonVus(base, u);
+    }
+    return false;
+}
+
+/**
+ * @brief Racine du sommet x dans la forêt union-find parent (compression par moitiés).
+ */
+static int racineSommet(int* parent, int x) {
+    while (parent[x] != x) {
+        parent[x] = parent[parent[x]];
+        x = parent[x];
+    }
+    return x;
+}
+
+/**
+ * @brief Composantes connexes de la base en union-find, dans base->parent (espace de parcours réutilisé) :
+ * un passage sur les mots de bits, puis une case relie deux composantes ssi ses extrémités ont des racines
+ * distinctes (même réponse que cheminExiste, sans parcours par case candidate).
+ */
+static void unirComposantesBase(BaseBinaire* b) {
+    int n = b->n;
+    for (int u = 0; u < n + b->m; u++) b->parent[u] = u;
+    for (int i = 0; i < n; i++) {
+        const uint64_t* ligne = b->lignes + (long)i * b->mots_lig;
+        for (int w = 0; w < b->mots_lig; w++) {
+            for (uint64_t bits = ligne[w]; bits; bits &= bits - 1) {
+                int a = racineSommet(b->parent, i);
+                int c = racineSommet(b->parent, n + (w << 6) + bitPoidsFaible(bits));
+                if (a != c) b->parent[c] = a;
             }
         }
     }
-    free(visite); libererQueue(q);
-    return found;
 }
 
 // ==========================================================
@@ -87,38 +188,202 @@ static bool cheminExiste(int n, int m, int** base, int start, int target) {
 // ==========================================================
 
 ProblemeTransport* creerProbleme(int n, int m) {
-    ProblemeTransport* p = (ProblemeTransport*)malloc(sizeof(ProblemeTransport));
-    if (!p) exit(EXIT_FAILURE);
+    ProblemeTransport* p = (ProblemeTransport*)calloc(1, sizeof(ProblemeTransport));
+    if (!p) return NULL;
     p->n = n; p->m = m;
-    p->A = (double**)malloc(n * sizeof(double*));
-    p->B = (int**)malloc(n * sizeof(int*));
-    for (int i = 0; i < n; i++) {
+    p->A = (double**)calloc(n, sizeof(double*));
+    p->B = (int**)calloc(n, sizeof(int*));
+    p->P = (int*)malloc(n * sizeof(int));
+    p->C = (int*)malloc(m * sizeof(int));
+    bool ok = p->A && p->B && p->P && p->C;
+    for (int i = 0; ok && i < n; i++) {
         p->A[i] = (double*)malloc(m * sizeof(double));
         p->B[i] = (int*)calloc(m, sizeof(int));
+        ok = p->A[i] && p->B[i];
     }
-    p->P = (int*)malloc(n * sizeof(int));
-    p->C = (int*)malloc(m * sizeof(int));
+    // At, U et ordres restent NULL (calloc)
+    if (!ok) { libererProbleme(p); return NULL; }
     return p;
 }
 
+static void libererCapacites(CapacitesCreuses* u) {
+    if (u) { free(u->debut); free(u->colonne); free(u->capacite); free(u); }
+}
+
 void libererProbleme(ProblemeTransport* p) {
     if (!p) return;
-    for (int i = 0; i < p->n; i++) { free(p->A[i]); free(p->B[i]); }
-    free(p->A); free(p->B); free(p->P); free(p->C);
+    for (int i = 0; i < p->n; i++) {
+        if (p->A) free(p->A[i]);
+        if (p->B) free(p->B[i]);
+    }
+    free(p->A); free(p->At); free(p->B); free(p->P); free(p->C);
+    libererCapacites(p->U);
+    invaliderOrdresCouts(p);
     free(p);
 }
 
-ProblemeTransport* lireDonnees(const char* nomFichier) {
+CodeRetour chargerDonnees(const char* nomFichier, ProblemeTransport** sortie) {
+    if (!sortie) return RETOUR_ARGUMENT_INVALIDE;
+    *sortie = NULL;
     FILE* f = fopen(nomFichier, "r");
-    if (!f) { perror("Erreur ouverture fichier"); return NULL; }
+    if (!f) { perror("Erreur ouverture fichier"); return RETOUR_ARGUMENT_INVALIDE; }
     int n, m;
-    if (fscanf(f, "%d %d", &n, &m) != 2) return NULL;
-    ProblemeTransport* p = creerProbleme(n, m);
-    for (int i = 0; i < n; i++) for (int j = 0; j < m; j++) fscanf(f, "%lf", &p->A[i][j]);
-    for (int i = 0; i < n; i++) fscanf(f, "%d", &p->P[i]);
-    for (int j = 0; j < m; j++) fscanf(f, "%d", &p->C[j]);
+    ProblemeTransport* p = NULL;
+    if (fscanf(f, "%d %d", &n, &m) != 2 || n <= 0 || m <= 0) {
+        fprintf(stderr, "Dimensions invalides dans '%s'\n", nomFichier);
+        fclose(f);
+        return RETOUR_ARGUMENT_INVALIDE;
+    }
+    if (!(p = creerProbleme(n, m))) { fclose(f); return RETOUR_MEMOIRE; }
+
+    // Un fichier tronqué ou une valeur illisible rejette l'instance au lieu de laisser des zéros
+    CodeRetour code = RETOUR_OK;
+    for (int i = 0; code == RETOUR_OK && i < n; i++)
+        for (int j = 0; code == RETOUR_OK && j < m; j++)
+            if (fscanf(f, "%lf", &p->A[i][j]) != 1 || !isfinite(p->A[i][j])) code = RETOUR_ARGUMENT_INVALIDE;
+    long total_offre = 0, total_demande = 0;
+    for (int i = 0; code == RETOUR_OK && i < n; i++) {
+        if (fscanf(f, "%d", &p->P[i]) != 1 || p->P[i] < 0) code = RETOUR_ARGUMENT_INVALIDE;
+        else total_offre += p->P[i];
+    }
+    for (int j = 0; code == RETOUR_OK && j < m; j++) {
+        if (fscanf(f, "%d", &p->C[j]) != 1 || p->C[j] < 0) code = RETOUR_ARGUMENT_INVALIDE;
+        else total_demande += p->C[j];
+    }
+    if (code != RETOUR_OK) {
+        fprintf(stderr, "Couts, offres ou demandes manquants ou invalides dans '%s'\n", nomFichier);
+    } else if (total_offre != total_demande) {
+        fprintf(stderr, "Probleme non equilibre dans '%s' (%ld vs %ld)\n", nomFichier, total_offre, total_demande);
+        code = RETOUR_DESEQUILIBRE;
+    } else if (!actualiserCouts(p)) {
+        code = RETOUR_MEMOIRE;
+    }
+
+    // Section optionnelle des capacités : K puis K triplets (i, j, U[i][j])
+    int k;
+    if (code == RETOUR_OK && fscanf(f, "%d", &k) == 1 && k != 0) {
+        bool ok = k > 0; // K négatif : section invalide
+        int* lignes = ok ? (int*)malloc(k * sizeof(int)) : NULL;
+        int* colonnes = ok ? (int*)malloc(k * sizeof(int)) : NULL;
+        int* capacites = ok ? (int*)malloc(k * sizeof(int)) : NULL;
+        ok = ok && lignes && colonnes && capacites;
+        for (int t = 0; ok && t < k; t++)
+            ok = fscanf(f, "%d %d %d", &lignes[t], &colonnes[t], &capacites[t]) == 3;
+        if (!ok || !definirCapacites(p, k, lignes, colonnes, capacites)) {
+            fprintf(stderr, "Section des capacites invalide dans '%s'\n", nomFichier);
+            code = RETOUR_ARGUMENT_INVALIDE;
+        }
+        free(lignes); free(colonnes); free(capacites);
+    }
     fclose(f);
-    return p;
+    if (code != RETOUR_OK) { libererProbleme(p); return code; }
+    *sortie = p;
+    return RETOUR_OK;
+}
+
+ProblemeTransport* lireDonnees(const char* nomFichier) {
+    ProblemeTransport* p;
+    return chargerDonnees(nomFichier, &p) == RETOUR_OK ? p : NULL;
+}
+
+bool actualiserCouts(ProblemeTransport* p) {
+    invaliderOrdresCouts(p);
+    if (!p->At) p->At = (double*)malloc((size_t)p->n * p->m * sizeof(double));
+    if (!p->At) return false;
+    // Transposition par blocs : lectures et écritures restent dans quelques lignes de cache
+    const int BLOC = 32;
+    for (int i0 = 0; i0 < p->n; i0 += BLOC)
+        for (int j0 = 0; j0 < p->m; j0 += BLOC)
+            for (int i = i0; i < i0 + BLOC && i < p->n; i++)
+                for (int j = j0; j < j0 + BLOC && j < p->m; j++)
+                    p->At[(long)j * p->n + i] = p->A[i][j];
+    return true;
+}
+
+bool definirCapacites(ProblemeTransport* p, int nb, const int* lignes, const int* colonnes, const int* capacites) {
+    for (int t = 0; t < nb; t++)
+        if (lignes[t] < 0 || lignes[t] >= p->n || colonnes[t] < 0 || colonnes[t] >= p->m || capacites[t] < 0)
+            return false;
+    libererCapacites(p->U);
+    p->U = NULL;
+    if (nb <= 0) return true;
+
+    CapacitesCreuses* u = (CapacitesCreuses*)malloc(sizeof(CapacitesCreuses));
+    int* remplis = (int*)calloc(p->n, sizeof(int));
+    if (u) {
+        u->debut = (int*)calloc(p->n + 1, sizeof(int));
+        u->colonne = (int*)malloc(nb * sizeof(int));
+        u->capacite = (int*)malloc(nb * sizeof(int));
+    }
+    if (!u || !remplis || !u->debut || !u->colonne || !u->capacite) {
+        libererCapacites(u); free(remplis);
+        return false;
+    }
+
+    // Répartition par ligne (comptage), puis tri par insertion des colonnes de chaque ligne
+    for (int t = 0; t < nb; t++) u->debut[lignes[t] + 1]++;
+    for (int i = 0; i < p->n; i++) u->debut[i + 1] += u->debut[i];
+    for (int t = 0; t < nb; t++) {
+        int i = lignes[t];
+        int pos = u->debut[i] + remplis[i]++;
+        while (pos > u->debut[i] && u->colonne[pos - 1] > colonnes[t]) {
+            u->colonne[pos] = u->colonne[pos - 1];
+            u->capacite[pos] = u->capacite[pos - 1];
+            pos--;
+        }
+        u->colonne[pos] = colonnes[t];
+        u->capacite[pos] = capacites[t];
+    }
+    free(remplis);
+
+    // Doublons : la plus petite capacité est retenue
+    int ecrit = 0;
+    for (int i = 0; i < p->n; i++) {
+        int debut = u->debut[i], fin = u->debut[i + 1];
+        u->debut[i] = ecrit;
+        for (int t = debut; t < fin; t++) {
+            if (ecrit > u->debut[i] && u->colonne[ecrit - 1] == u->colonne[t]) {
+                if (u->capacite[t] < u->capacite[ecrit - 1]) u->capacite[ecrit - 1] = u->capacite[t];
+            } else {
+                u->colonne[ecrit] = u->colonne[t];
+                u->capacite[ecrit++] = u->capacite[t];
+            }
+        }
+    }
+    u->debut[p->n] = ecrit;
+    u->nb = ecrit;
+    p->U = u;
+    return true;
+}
+
+int capaciteCase(const ProblemeTransport* p, int i, int j) {
+    if (!p->U) return INT_MAX;
+    int bas = p->U->debut[i], haut = p->U->debut[i + 1] - 1;
+    while (bas <= haut) {
+        int milieu = (bas + haut) / 2;
+        int c = p->U->colonne[milieu];
+        if (c == j) return p->U->capacite[milieu];
+        if (c < j) bas = milieu + 1;
+        else haut = milieu - 1;
+    }
+    return INT_MAX;
+}
+
+bool solutionAdmissible(const ProblemeTransport* p) {
+    for (int i = 0; i < p->n; i++) {
+        long somme = 0;
+        for (int j = 0; j < p->m; j++) {
+            if (p->B[i][j] < 0 || p->B[i][j] > capaciteCase(p, i, j)) return false;
+            somme += p->B[i][j];
+        }
+        if (somme != p->P[i]) return false;
+    }
+    for (int j = 0; j < p->m; j++) {
+        long somme = 0;
+        for (int i = 0; i < p->n; i++) somme += p->B[i][j];
+        if (somme != p->C[j]) return false;
+    }
+    return true;
 }
 
 void reinitialiserSolution(ProblemeTransport* p) {
@@ -126,6 +391,32 @@ void reinitialiserSolution(ProblemeTransport* p) {
     for (int i = 0; i < p->n; i++) for (int j = 0; j < p->m; j++) p->B[i][j] = 0;
 }
 
+ProblemeTransport* creerProblemePartage(const ProblemeTransport* source) {
+    ProblemeTransport* p = (ProblemeTransport*)malloc(sizeof(ProblemeTransport));
+    if (!p) return NULL;
+    *p = *source;
+    p->ordres_possedes = false; // Cache des ordres partagé avec la source
+    p->B = (int**)malloc(p->n * sizeof(int*));
+    if (!p->B) { free(p); return NULL; }
+    for (int i = 0; i < p->n; i++) {
+        p->B[i] = (int*)calloc(p->m, sizeof(int));
+        if (!p->B[i]) {
+            while (i-- > 0) free(p->B[i]);
+            free(p->B); free(p);
+            return NULL;
+        }
+    }
+    return p;
+}
+
+void libererProblemePartage(ProblemeTransport* p) {
+    if (!p) return;
+    for (int i = 0; i < p->n; i++) free(p->B[i]);
+    free(p->B);
+    invaliderOrdresCouts(p); // Libère un cache calculé par la vue elle-même
+    free(p);
+}
+
 // ==========================================================
 // 2. AFFICHAGE
 // ==========================================================
@@ -180,12 +471,12 @@ void afficherTableauPotentiels(ProblemeTransport* p, double* E_s, double* E_t) {
     }
 }
 
-void afficherTableauMarginaux(ProblemeTransport* p, double** couts_marginaux, int** base) {
+void afficherTableauMarginaux(ProblemeTransport* p, double** couts_marginaux, BaseBinaire* base) {
     printf("\n--- COUTS MARGINAUX (Delta = Cij - (Es - Et)) ---\n");
     for (int i = 0; i < p->n; i++) {
         printf(" F%-4d ", i);
         for (int j = 0; j < p->m; j++) {
-            if (base[i][j]) printf("   B   ");
+            if (estDeBase(base, i, j)) printf("   B   ");
             else printf("%6.2f ", couts_marginaux[i][j]);
         }
         printf("\n");
@@ -193,851 +484,937 @@ void afficherTableauMarginaux(ProblemeTransport* p, double** couts_marginaux, in
 }
 
 // ==========================================================
-// 3. ALGORITHMES INITIAUX
+// 3. POTENTIELS ET COUTS MARGINAUX
 // ==========================================================
 
-void algoNordOuest(ProblemeTransport* p) {
-    reinitialiserSolution(p);
-    int* P = (int*)malloc(p->n * sizeof(int));
-    int* C = (int*)malloc(p->m * sizeof(int));
-    memcpy(P, p->P, p->n * sizeof(int));
-    memcpy(C, p->C, p->m * sizeof(int));
-
-    printf("\n=== ALGORITHME NORD-OUEST ===\n");
-
-    int i = 0, j = 0;
-    int etape = 1;
-
-    while (i < p->n && j < p->m) {
-        int q = (P[i] < C[j]) ? P[i] : C[j];
-        p->B[i][j] = q;
-        P[i] -= q; C[j] -= q;
-
-        printf("Etape %d: Case (%d,%d) = %d (Prov_rest=%d, Comm_rest=%d)\n",
-               etape++, i, j, q, P[i], C[j]);
-
-        if (P[i] == 0 && C[j] == 0) {
-            if (i < p->n - 1) i++;
-            else j++;
-        }
-        else if (P[i] == 0) i++;
-        else j++;
-    }
-
-    printf("=== FIN NORD-OUEST ===\n");
-    free(P); free(C);
-}
-
-// Version silencieuse pour les pipelines (options 3 et 4)
-void algoNordOuestSilencieux(ProblemeTransport* p) {
-    reinitialiserSolution(p);
-    int* P = (int*)malloc(p->n * sizeof(int));
-    int* C = (int*)malloc(p->m * sizeof(int));
-    memcpy(P, p->P, p->n * sizeof(int));
-    memcpy(C, p->C, p->m * sizeof(int));
-
-    int i = 0, j = 0;
-
-    while (i < p->n && j < p->m) {
-        int q = (P[i] < C[j]) ? P[i] : C[j];
-        p->B[i][j] = q;
-        P[i] -= q; C[j] -= q;
+void calculerPotentiels(ProblemeTransport* p, BaseBinaire* base, double* E_s, double* E_t) {
+    for(int i=0; i<p->n; i++) E_s[i] = DBL_MAX;
+    for(int j=0; j<p->m; j++) E_t[j] = DBL_MAX;
 
-        if (P[i] == 0 && C[j] == 0) {
-            if (i < p->n - 1) i++;
-            else j++;
-        }
-        else if (P[i] == 0) i++;
-        else j++;
+    // Potentiel d'un sommet fixé à sa sortie de file, depuis celui de son parent dans le BFS
+    debuterParcours(base, 0);
+    while(!isQueueEmpty(base->file)) {
+        BFSNode noeud = dequeue(base->file);
+        int u = noeud.index, par = noeud.parent;
+        if (par == -1) E_s[u] = 0.0;
+        else if (u < p->n) E_s[u] = p->A[u][par - p->n] + E_t[par - p->n];
+        else E_t[u - p->n] = E_s[par] - p->A[par][u - p->n];
+        enfilerVoisinsNonVus(base, u);
     }
-
-    free(P); free(C);
 }
 
-void algoBalasHammer(ProblemeTransport* p) {
-    reinitialiserSolution(p);
-    int* P = (int*)malloc(p->n * sizeof(int));
-    int* C = (int*)malloc(p->m * sizeof(int));
-    memcpy(P, p->P, p->n * sizeof(int));
-    memcpy(C, p->C, p->m * sizeof(int));
-
-    int* row_sat = (int*)calloc(p->n, sizeof(int));
-    int* col_sat = (int*)calloc(p->m, sizeof(int));
-    int n_rows = p->n, n_cols = p->m;
-
-    int iteration = 0;
-
-    printf("\n=== ALGORITHME BALAS-HAMMER (VOGEL) ===\n");
-
-    while (n_rows > 0 && n_cols > 0) {
-        iteration++;
-        printf("\n--- ITERATION %d ---\n", iteration);
-
-        double max_pen = -1.0;
-        int idx_best = -1;
-        bool is_row = true;
-
-        printf("\nPenalites LIGNES :\n");
+bool calculerCoutsMarginaux(ProblemeTransport* p, BaseBinaire* base, double* E_s, double* E_t,
+                            int* i_ajout, int* j_ajout, double** couts_marginaux) {
+    double meilleur_gain = -EPSILON;
+    *i_ajout = -1; *j_ajout = -1;
+    bool amelioration = false;
 
+    if (p->U) {
+        // Case hors base non vide = case à sa capacité : gain = -delta (on diminue sa quantité)
         for (int i = 0; i < p->n; i++) {
-            if (row_sat[i]) continue;
-            double m1 = DBL_MAX, m2 = DBL_MAX;
             for (int j = 0; j < p->m; j++) {
-                if (!col_sat[j]) {
-                    if (p->A[i][j] < m1) { m2 = m1; m1 = p->A[i][j]; }
-                    else if (p->A[i][j] < m2) { m2 = p->A[i][j]; }
+                if (estDeBase(base, i, j)) { couts_marginaux[i][j] = 0.0; continue; }
+                double delta = p->A[i][j] - (E_s[i] - E_t[j]);
+                couts_marginaux[i][j] = delta;
+                double gain = (p->B[i][j] > 0) ? -delta : delta;
+                // Une case de capacité nulle ne peut pas entrer
+                if (gain < meilleur_gain && (p->B[i][j] > 0 || capaciteCase(p, i, j) > 0)) {
+                    meilleur_gain = gain;
+                    *i_ajout = i; *j_ajout = j;
+                    amelioration = true;
                 }
             }
-            double pen = (m2 == DBL_MAX) ? m1 : (m2 - m1);
-            printf("  F%-2d : %.2f", i, pen);
-
-            if (pen > max_pen) {
-                max_pen = pen;
-                idx_best = i;
-                is_row = true;
-                printf(" <- MAX");
-            }
-            printf("\n");
         }
+        return amelioration;
+    }
 
-        printf("\nPenalites COLONNES :\n");
-
+    for (int i = 0; i < p->n; i++) {
         for (int j = 0; j < p->m; j++) {
-            if (col_sat[j]) continue;
-            double m1 = DBL_MAX, m2 = DBL_MAX;
-            for (int i = 0; i < p->n; i++) {
-                if (!row_sat[i]) {
-                    if (p->A[i][j] < m1) { m2 = m1; m1 = p->A[i][j]; }
-                    else if (p->A[i][j] < m2) { m2 = p->A[i][j]; }
+            if (estDeBase(base, i, j)) {
+                couts_marginaux[i][j] = 0.0;
+            } else {
+                double delta = p->A[i][j] - (E_s[i] - E_t[j]);
+                couts_marginaux[i][j] = delta;
+
+                if (delta < meilleur_gain) {
+                    meilleur_gain = delta;
+                    *i_ajout = i;
+                    *j_ajout = j;
+                    amelioration = true;
                 }
             }
-            double pen = (m2 == DBL_MAX) ? m1 : (m2 - m1);
-            printf("  C%-2d : %.2f", j, pen);
-
-            if (pen > max_pen) {
-                max_pen = pen;
-                idx_best = j;
-                is_row = false;
-                printf(" <- MAX");
-            }
-            printf("\n");
         }
+    }
+    return amelioration;
+}
 
-        if (is_row) {
-            printf("\n>>> Penalite MAX : Ligne F%d (%.2f)\n", idx_best, max_pen);
-        } else {
-            printf("\n>>> Penalite MAX : Colonne C%d (%.2f)\n", idx_best, max_pen);
+/**
+ * @brief Règle de Bland pour la case entrante : première case améliorante dans l'ordre (i, j).
+ * Utilisée pendant une suite de pas dégénérés ; avec la sortante d'indice minimal du cycle,
+ * elle exclut le cyclage. Lit les coûts marginaux déjà calculés par le pricing.
+ */
+static bool choisirEntranteBland(const ProblemeTransport* p, const BaseBinaire* base, double** couts_marginaux,
+                                 int* i_ajout, int* j_ajout) {
+    for (int i = 0; i < p->n; i++) {
+        for (int j = 0; j < p->m; j++) {
+            if (estDeBase(base, i, j)) continue;
+            double gain = (p->U && p->B[i][j] > 0) ? -couts_marginaux[i][j] : couts_marginaux[i][j];
+            if (gain < -EPSILON && (!p->U || p->B[i][j] > 0 || capaciteCase(p, i, j) > 0)) {
+                *i_ajout = i; *j_ajout = j;
+                return true;
+            }
         }
+    }
+    return false;
+}
 
-        int r = -1, c = -1;
-        double min_cost = DBL_MAX;
+double borneEcartOptimalite(ProblemeTransport* p, double* E_s, double* E_t) {
+    int n = p->n, m = p->m;
+    double* min_colonne = (double*)malloc(m * sizeof(double));
+    if (!min_colonne) return DBL_MAX;
+    for (int j = 0; j < m; j++) min_colonne[j] = 0.0;
 
-        if (is_row) {
-            r = idx_best;
-            for (int j = 0; j < p->m; j++) {
-                if (!col_sat[j] && p->A[r][j] < min_cost) {
-                    min_cost = p->A[r][j];
-                    c = j;
-                }
-            }
-        } else {
-            c = idx_best;
-            for (int i = 0; i < p->n; i++) {
-                if (!row_sat[i] && p->A[i][c] < min_cost) {
-                    min_cost = p->A[i][c];
-                    r = i;
-                }
-            }
+    // Objectif dual des potentiels bruts, puis corrections ligne / colonne
+    double dual = 0.0, correction_lignes = 0.0, correction_colonnes = 0.0;
+    for (int i = 0; i < n; i++) {
+        double es = (E_s[i] == DBL_MAX) ? 0.0 : E_s[i];
+        double min_ligne = 0.0;
+        for (int j = 0; j < m; j++) {
+            double et = (E_t[j] == DBL_MAX) ? 0.0 : E_t[j];
+            double delta = p->A[i][j] - (es - et);
+            if (delta < min_ligne) min_ligne = delta;
+            if (delta < min_colonne[j]) min_colonne[j] = delta;
         }
+        dual += p->P[i] * es;
+        correction_lignes += p->P[i] * min_ligne;
+    }
+    for (int j = 0; j < m; j++) {
+        double et = (E_t[j] == DBL_MAX) ? 0.0 : E_t[j];
+        dual -= p->C[j] * et;
+        correction_colonnes += p->C[j] * min_colonne[j];
+    }
+    free(min_colonne);
 
-        if (r == -1 || c == -1) break;
+    double minorant = dual + ((correction_lignes > correction_colonnes) ? correction_lignes : correction_colonnes);
+    double ecart = calculerCoutTotal(p) - minorant;
+    return (ecart > 0.0) ? ecart : 0.0;
+}
 
-        printf(">>> Case choisie : (%d, %d) [Cout=%.2f]\n", r, c, min_cost);
+// =========================================================================
+// 4. SOLUTION CREUSE ET EXPORT
+// =========================================================================
 
-        int q = (P[r] < C[c]) ? P[r] : C[c];
-        p->B[r][c] = q;
-        P[r] -= q; C[c] -= q;
+// Identifiant et version du format binaire
+static const char MAGIC_SOLUTION[4] = { 'R', 'O', 'S', 'C' };
+#define VERSION_FORMAT_SOLUTION 2u
+
+SolutionCreuse* creerSolutionCreuse(int n, int m) {
+    SolutionCreuse* s = (SolutionCreuse*)malloc(sizeof(SolutionCreuse));
+    if (!s) return NULL;
+    s->n = n; s->m = m;
+    s->nb_cases = 0;
+    // n + m - 1 calculé en long : pas de débordement pour des dimensions proches de INT_MAX
+    long capacite = (long)n + m - 1;
+    if (capacite > INT_MAX) { free(s); return NULL; }
+    s->capacite = capacite > 1 ? (int)capacite : 1;
+    s->cout_total = 0.0;
+    s->E_s = NULL;
+    s->E_t = NULL;
+    s->cases = (CaseBase*)malloc((size_t)s->capacite * sizeof(CaseBase));
+    if (!s->cases) { free(s); return NULL; }
+    return s;
+}
 
-        printf(">>> Quantite affectee : %d\n", q);
+void libererSolutionCreuse(SolutionCreuse* s) {
+    if (s) { free(s->cases); free(s->E_s); free(s->E_t); free(s); }
+}
 
-        if (P[r] == 0 && C[c] == 0) {
-            if (n_rows > 1 || n_cols > 1) {
-                row_sat[r] = 1; n_rows--;
-                printf(">>> Ligne F%d saturee.\n", r);
-            } else {
-                row_sat[r] = 1; col_sat[c] = 1;
-                n_rows--; n_cols--;
-                printf(">>> Ligne F%d et Colonne C%d saturees (derniere iteration).\n", r, c);
-            }
-        }
-        else if (P[r] == 0) {
-            row_sat[r] = 1; n_rows--;
-            printf(">>> Ligne F%d saturee.\n", r);
-        }
-        else if (C[c] == 0) {
-            col_sat[c] = 1; n_cols--;
-            printf(">>> Colonne C%d saturee.\n", c);
-        }
+SolutionCreuse* copierSolutionCreuse(const SolutionCreuse* s) {
+    SolutionCreuse* copie = creerSolutionCreuse(s->n, s->m);
+    if (!copie) return NULL;
+    if (s->nb_cases > copie->capacite) {
+        CaseBase* tmp = (CaseBase*)realloc(copie->cases, s->nb_cases * sizeof(CaseBase));
+        if (!tmp) { libererSolutionCreuse(copie); return NULL; }
+        copie->cases = tmp;
+        copie->capacite = s->nb_cases;
     }
-
-    printf("\n=== FIN BALAS-HAMMER ===\n");
-    free(P); free(C); free(row_sat); free(col_sat);
+    memcpy(copie->cases, s->cases, s->nb_cases * sizeof(CaseBase));
+    copie->nb_cases = s->nb_cases;
+    copie->cout_total = s->cout_total;
+    if (s->E_s && s->E_t && !attacherPotentielsSolution(copie, s->E_s, s->E_t)) {
+        libererSolutionCreuse(copie);
+        return NULL;
+    }
+    return copie;
 }
 
-// Version silencieuse pour les pipelines (options 3 et 4)
-void algoBalasHammerSilencieux(ProblemeTransport* p) {
-    reinitialiserSolution(p);
-    int* P = (int*)malloc(p->n * sizeof(int));
-    int* C = (int*)malloc(p->m * sizeof(int));
-    memcpy(P, p->P, p->n * sizeof(int));
-    memcpy(C, p->C, p->m * sizeof(int));
-
-    int* row_sat = (int*)calloc(p->n, sizeof(int));
-    int* col_sat = (int*)calloc(p->m, sizeof(int));
-    int n_rows = p->n, n_cols = p->m;
+bool attacherPotentielsSolution(SolutionCreuse* s, const double* E_s, const double* E_t) {
+    if (!s->E_s) s->E_s = (double*)malloc(s->n * sizeof(double));
+    if (!s->E_t) s->E_t = (double*)malloc(s->m * sizeof(double));
+    if (!s->E_s || !s->E_t) {
+        free(s->E_s); free(s->E_t);
+        s->E_s = NULL; s->E_t = NULL;
+        return false;
+    }
+    memcpy(s->E_s, E_s, s->n * sizeof(double));
+    memcpy(s->E_t, E_t, s->m * sizeof(double));
+    return true;
+}
 
-    while (n_rows > 0 && n_cols > 0) {
-        double max_pen = -1.0;
-        int idx_best = -1;
-        bool is_row = true;
+bool verifierCertificatOptimalite(const ProblemeTransport* p, const SolutionCreuse* s,
+                                  double tolerance, RapportCertificat* rapport) {
+    RapportCertificat r = { false, false, 0.0, 0.0, 0.0, DBL_MAX };
+    int n = p->n, m = p->m;
 
-        for (int i = 0; i < p->n; i++) {
-            if (row_sat[i]) continue;
-            double m1 = DBL_MAX, m2 = DBL_MAX;
-            for (int j = 0; j < p->m; j++) {
-                if (!col_sat[j]) {
-                    if (p->A[i][j] < m1) { m2 = m1; m1 = p->A[i][j]; }
-                    else if (p->A[i][j] < m2) { m2 = p->A[i][j]; }
-                }
+    // 1. Admissibilité primale : sommes par ligne et par colonne
+    long* offre = (long*)calloc(n, sizeof(long));
+    long* demande = (long*)calloc(m, sizeof(long));
+    if (offre && demande && s->n == n && s->m == m) {
+        r.admissible_primal = true;
+        for (int k = 0; k < s->nb_cases; k++) {
+            const CaseBase* c = &s->cases[k];
+            if (c->i < 0 || c->i >= n || c->j < 0 || c->j >= m || c->quantite < 0
+                || c->quantite > capaciteCase(p, c->i, c->j)) {
+                r.admissible_primal = false;
+                break;
             }
-            double pen = (m2 == DBL_MAX) ? m1 : (m2 - m1);
-            if (pen > max_pen) { max_pen = pen; idx_best = i; is_row = true; }
+            offre[c->i] += c->quantite;
+            demande[c->j] += c->quantite;
+            r.cout_primal += p->A[c->i][c->j] * c->quantite;
         }
+        for (int i = 0; r.admissible_primal && i < n; i++) if (offre[i] != p->P[i]) r.admissible_primal = false;
+        for (int j = 0; r.admissible_primal && j < m; j++) if (demande[j] != p->C[j]) r.admissible_primal = false;
+    }
+    free(offre); free(demande);
 
-        for (int j = 0; j < p->m; j++) {
-            if (col_sat[j]) continue;
-            double m1 = DBL_MAX, m2 = DBL_MAX;
-            for (int i = 0; i < p->n; i++) {
-                if (!row_sat[i]) {
-                    if (p->A[i][j] < m1) { m2 = m1; m1 = p->A[i][j]; }
-                    else if (p->A[i][j] < m2) { m2 = p->A[i][j]; }
-                }
+    // 2. Admissibilité duale et 3. écart de dualité
+    if (s->E_s && s->E_t && s->n == n && s->m == m) {
+        r.pire_cout_marginal = DBL_MAX;
+        for (int i = 0; i < n; i++) {
+            for (int j = 0; j < m; j++) {
+                double delta = p->A[i][j] - (s->E_s[i] - s->E_t[j]);
+                int u = capaciteCase(p, i, j);
+                // Case plafonnée : le dual de sa capacité absorbe un coût marginal négatif
+                if (u != INT_MAX) { if (delta < 0.0) r.cout_dual += u * delta; continue; }
+                if (delta < r.pire_cout_marginal) r.pire_cout_marginal = delta;
             }
-            double pen = (m2 == DBL_MAX) ? m1 : (m2 - m1);
-            if (pen > max_pen) { max_pen = pen; idx_best = j; is_row = false; }
+            r.cout_dual += p->P[i] * s->E_s[i];
         }
+        for (int j = 0; j < m; j++) r.cout_dual -= p->C[j] * s->E_t[j];
+        r.admissible_dual = r.pire_cout_marginal >= -tolerance;
+        r.ecart_dualite = fabs(r.cout_primal - r.cout_dual);
+    }
 
-        int r = -1, c = -1;
-        double min_cost = DBL_MAX;
-
-        if (is_row) {
-            r = idx_best;
-            for (int j = 0; j < p->m; j++) {
-                if (!col_sat[j] && p->A[r][j] < min_cost) { min_cost = p->A[r][j]; c = j; }
-            }
-        } else {
-            c = idx_best;
-            for (int i = 0; i < p->n; i++) {
-                if (!row_sat[i] && p->A[i][c] < min_cost) { min_cost = p->A[i][c]; r = i; }
-            }
-        }
+    if (rapport) *rapport = r;
+    return r.admissible_primal && r.admissible_dual
+        && r.ecart_dualite <= tolerance * (1.0 + fabs(r.cout_primal));
+}
 
-        if (r == -1 || c == -1) break;
+bool exporterDualeCSV(const SolutionCreuse* s, const char* nomFichier) {
+    if (!s->E_s || !s->E_t) return false;
+    FILE* f = fopen(nomFichier, "w");
+    if (!f) { perror("Erreur ouverture fichier"); return false; }
+    fprintf(f, "type,indice,potentiel\n");
+    for (int i = 0; i < s->n; i++) fprintf(f, "s,%d,%.15g\n", i, s->E_s[i]);
+    for (int j = 0; j < s->m; j++) fprintf(f, "t,%d,%.15g\n", j, s->E_t[j]);
+    return fclose(f) == 0;
+}
 
-        int q = (P[r] < C[c]) ? P[r] : C[c];
-        p->B[r][c] = q;
-        P[r] -= q; C[c] -= q;
+bool ajouterCaseBase(SolutionCreuse* s, int i, int j, int quantite, double cout) {
+    if (s->nb_cases == s->capacite) {
+        if (s->capacite > INT_MAX / 2) return false;
+        int nouvelle = 2 * s->capacite;
+        CaseBase* tmp = (CaseBase*)realloc(s->cases, (size_t)nouvelle * sizeof(CaseBase));
+        if (!tmp) return false;
+        s->cases = tmp;
+        s->capacite = nouvelle;
+    }
+    CaseBase* c = &s->cases[s->nb_cases++];
+    c->i = i; c->j = j;
+    c->quantite = quantite;
+    c->cout = cout;
+    s->cout_total += cout * quantite;
+    return true;
+}
 
-        if (P[r] == 0 && C[c] == 0) {
-            if (n_rows > 1 || n_cols > 1) {
-                row_sat[r] = 1; n_rows--;
-            } else {
-                row_sat[r] = 1; col_sat[c] = 1;
-                n_rows--; n_cols--;
+SolutionCreuse* extraireSolutionCreuse(ProblemeTransport* p) {
+    SolutionCreuse* s = creerSolutionCreuse(p->n, p->m);
+    if (!s) return NULL;
+    for (int i = 0; i < p->n; i++) {
+        for (int j = 0; j < p->m; j++) {
+            if (p->B[i][j] != 0 && !ajouterCaseBase(s, i, j, p->B[i][j], p->A[i][j])) {
+                libererSolutionCreuse(s);
+                return NULL;
             }
         }
-        else if (P[r] == 0) { row_sat[r] = 1; n_rows--; }
-        else if (C[c] == 0) { col_sat[c] = 1; n_cols--; }
     }
+    return s;
+}
 
-    free(P); free(C); free(row_sat); free(col_sat);
+void appliquerSolutionCreuse(ProblemeTransport* p, const SolutionCreuse* s) {
+    reinitialiserSolution(p);
+    for (int k = 0; k < s->nb_cases; k++) p->B[s->cases[k].i][s->cases[k].j] = s->cases[k].quantite;
 }
 
-// ==========================================================
-// 4. MARCHE-PIED (OPTIMISATION)
-// ==========================================================
+bool appliquerBaseVoisine(ProblemeTransport* p, const SolutionCreuse* base) {
+    int n = p->n, m = p->m, nb_noeuds = n + m;
+    if (p->U || base->n != n || base->m != m || base->nb_cases != nb_noeuds - 1) return false;
+    for (int k = 0; k < base->nb_cases; k++)
+        if (base->cases[k].i < 0 || base->cases[k].i >= n || base->cases[k].j < 0 || base->cases[k].j >= m)
+            return false;
+
+    // Incidence compacte : cases[debut[u]..debut[u+1]-1] = cases de base touchant le noeud u
+    int* debut = (int*)calloc(nb_noeuds + 1, sizeof(int));
+    int* cases = (int*)malloc(2 * base->nb_cases * sizeof(int));
+    int* degre = (int*)malloc(nb_noeuds * sizeof(int));
+    long* reste = (long*)malloc(nb_noeuds * sizeof(long));
+    int* quantite = (int*)malloc(base->nb_cases * sizeof(int));
+    bool* traitee = (bool*)calloc(base->nb_cases, sizeof(bool));
+    Queue* feuilles = creerQueue(nb_noeuds);
+    bool ok = debut && cases && degre && reste && quantite && traitee && feuilles;
+
+    for (int k = 0; ok && k < base->nb_cases; k++) {
+        debut[base->cases[k].i + 1]++;
+        debut[n + base->cases[k].j + 1]++;
+    }
+    for (int u = 0; ok && u < nb_noeuds; u++) {
+        debut[u + 1] += debut[u];
+        degre[u] = 0;
+    }
+    for (int k = 0; ok && k < base->nb_cases; k++) {
+        int u = base->cases[k].i, v = n + base->cases[k].j;
+        cases[debut[u] + degre[u]++] = k;
+        cases[debut[v] + degre[v]++] = k;
+    }
 
-bool testerConnexite(ProblemeTransport* p, int** base) {
-    int n = p->n, m = p->m;
-    int total = n + m;
+    // Élimination des feuilles : la case d'une feuille porte tout le reste de son offre / sa demande
+    int traitees = 0;
+    if (ok) {
+        for (int i = 0; i < n; i++) reste[i] = p->P[i];
+        for (int j = 0; j < m; j++) reste[n + j] = p->C[j];
+        for (int u = 0; u < nb_noeuds; u++) if (degre[u] == 1) enqueue(feuilles, u, -1);
+        while (ok && !isQueueEmpty(feuilles)) {
+            int u = dequeue(feuilles).index;
+            if (degre[u] != 1) continue; // Dernier noeud : son reste doit être nul
+            int k = -1;
+            for (int e = debut[u]; e < debut[u + 1]; e++) if (!traitee[cases[e]]) { k = cases[e]; break; }
+            int v = (u < n) ? n + base->cases[k].j : base->cases[k].i;
+            if (reste[u] < 0 || reste[u] > INT_MAX) { ok = false; break; }
+            quantite[k] = (int)reste[u];
+            reste[v] -= reste[u];
+            reste[u] = 0;
+            traitee[k] = true;
+            traitees++;
+            degre[u]--;
+            if (--degre[v] == 1) enqueue(feuilles, v, u);
+        }
+    }
+    ok = ok && traitees == base->nb_cases;
+    for (int u = 0; ok && u < nb_noeuds; u++) if (reste[u] != 0) ok = false;
 
-    bool* visite = (bool*)calloc(total, sizeof(bool));
-    Queue* q = creerQueue(total);
+    if (ok) {
+        reinitialiserSolution(p);
+        for (int k = 0; k < base->nb_cases; k++) p->B[base->cases[k].i][base->cases[k].j] = quantite[k];
+    }
+    free(debut); free(cases); free(degre); free(reste); free(quantite); free(traitee);
+    libererQueue(feuilles);
+    return ok;
+}
 
-    enqueue(q, 0, -1);
-    visite[0] = true;
-    int nb_visites = 1;
+void afficherSolutionCreuse(const SolutionCreuse* s) {
+    if (!s) return;
+    printf("\n--- SOLUTION (cases de base : %d) ---\n", s->nb_cases);
+    for (int k = 0; k < s->nb_cases; k++) {
+        const CaseBase* c = &s->cases[k];
+        printf("  (F%d, C%d) : %6d x %.2f\n", c->i, c->j, c->quantite, c->cout);
+    }
+    printf(">>> Cout total : %.2f\n", s->cout_total);
+}
 
-    while(!isQueueEmpty(q)) {
-        int u = dequeue(q).index;
+bool exporterSolutionCSV(const SolutionCreuse* s, const char* nomFichier) {
+    FILE* f = fopen(nomFichier, "w");
+    if (!f) { perror("Erreur ouverture fichier"); return false; }
+    fprintf(f, "i,j,quantite,cout\n");
+    for (int k = 0; k < s->nb_cases; k++) {
+        const CaseBase* c = &s->cases[k];
+        fprintf(f, "%d,%d,%d,%.15g\n", c->i, c->j, c->quantite, c->cout);
+    }
+    return fclose(f) == 0;
+}
 
-        if (u < n) {
-            for (int j = 0; j < m; j++) {
-                if (base[u][j] && !visite[n + j]) {
-                    visite[n + j] = true;
-                    nb_visites++;
-                    enqueue(q, n + j, u);
-                }
-            }
-        } else {
-            for (int i = 0; i < n; i++) {
-                if (base[i][u - n] && !visite[i]) {
-                    visite[i] = true;
-                    nb_visites++;
-                    enqueue(q, i, u);
-                }
-            }
-        }
+bool exporterSolutionJSON(const SolutionCreuse* s, const char* nomFichier) {
+    FILE* f = fopen(nomFichier, "w");
+    if (!f) { perror("Erreur ouverture fichier"); return false; }
+    fprintf(f, "{\"n\":%d,\"m\":%d,\"cout_total\":%.15g,\"cases\":[", s->n, s->m, s->cout_total);
+    for (int k = 0; k < s->nb_cases; k++) {
+        const CaseBase* c = &s->cases[k];
+        fprintf(f, "%s\n{\"i\":%d,\"j\":%d,\"quantite\":%d,\"cout\":%.15g}",
+                (k > 0) ? "," : "", c->i, c->j, c->quantite, c->cout);
+    }
+    fprintf(f, "\n]");
+    if (s->E_s && s->E_t) {
+        fprintf(f, ",\n\"E_s\":[");
+        for (int i = 0; i < s->n; i++) fprintf(f, "%s%.15g", (i > 0) ? "," : "", s->E_s[i]);
+        fprintf(f, "],\n\"E_t\":[");
+        for (int j = 0; j < s->m; j++) fprintf(f, "%s%.15g", (j > 0) ? "," : "", s->E_t[j]);
+        fprintf(f, "]");
     }
+    fprintf(f, "}\n");
+    return fclose(f) == 0;
+}
 
-    bool connexe = (nb_visites == total);
+bool ecrireSolutionBinaire(const SolutionCreuse* s, FILE* f) {
+    uint32_t version = VERSION_FORMAT_SOLUTION;
+    int32_t entete[3] = { s->n, s->m, s->nb_cases };
+    bool ok = fwrite(MAGIC_SOLUTION, 1, 4, f) == 4
+           && fwrite(&version, sizeof(version), 1, f) == 1
+           && fwrite(entete, sizeof(int32_t), 3, f) == 3
+           && fwrite(&s->cout_total, sizeof(double), 1, f) == 1;
+    for (int k = 0; ok && k < s->nb_cases; k++) {
+        const CaseBase* c = &s->cases[k];
+        int32_t champs[3] = { c->i, c->j, c->quantite };
+        ok = fwrite(champs, sizeof(int32_t), 3, f) == 3
+          && fwrite(&c->cout, sizeof(double), 1, f) == 1;
+    }
+    int32_t a_duale = (s->E_s && s->E_t) ? 1 : 0;
+    ok = ok && fwrite(&a_duale, sizeof(int32_t), 1, f) == 1;
+    if (ok && a_duale) {
+        ok = fwrite(s->E_s, sizeof(double), s->n, f) == (size_t)s->n
+          && fwrite(s->E_t, sizeof(double), s->m, f) == (size_t)s->m;
+    }
+    return ok;
+}
 
-    if (!connexe) {
-        printf("\n[GRAPHE NON CONNEXE]\n");
-        printf("  Composante principale : { ");
-        for(int i = 0; i < n; i++) {
-            if(visite[i]) printf("F%d ", i);
-        }
-        for(int j = 0; j < m; j++) {
-            if(visite[n + j]) printf("C%d ", j);
-        }
-        printf("} (%d sommets)\n", nb_visites);
+bool exporterSolutionBinaire(const SolutionCreuse* s, const char* nomFichier) {
+    FILE* f = fopen(nomFichier, "wb");
+    if (!f) { perror("Erreur ouverture fichier"); return false; }
+    bool ok = ecrireSolutionBinaire(s, f);
+    return (fclose(f) == 0) && ok;
+}
 
-        if (nb_visites < total) {
-            printf("  Sommets isoles : { ");
-            for(int i = 0; i < n; i++) {
-                if(!visite[i]) printf("F%d ", i);
-            }
-            for(int j = 0; j < m; j++) {
-                if(!visite[n + j]) printf("C%d ", j);
-            }
-            printf("} (%d sommets)\n", total - nb_visites);
+SolutionCreuse* lireSolutionBinaireFlux(FILE* f) {
+    char magic[4];
+    uint32_t version;
+    int32_t entete[3];
+    double cout_total;
+    if (fread(magic, 1, 4, f) != 4 || memcmp(magic, MAGIC_SOLUTION, 4) != 0
+        || fread(&version, sizeof(version), 1, f) != 1 || version < 1 || version > VERSION_FORMAT_SOLUTION
+        || fread(entete, sizeof(int32_t), 3, f) != 3 || entete[0] <= 0 || entete[1] <= 0 || entete[2] < 0
+        || fread(&cout_total, sizeof(double), 1, f) != 1)
+        return NULL;
+    // En-tête corrompu : dimensions dont la base déborde un int, ou plus de cases que la grille n'en a
+    if ((long)entete[0] + entete[1] > INT_MAX || entete[2] > (long)entete[0] * entete[1]) return NULL;
+    SolutionCreuse* s = creerSolutionCreuse(entete[0], entete[1]);
+    for (int k = 0; s && k < entete[2]; k++) {
+        int32_t champs[3];
+        double cout;
+        // Fichier de cache ou de reprise corrompu : une case hors de la grille n'est jamais appliquée
+        if (fread(champs, sizeof(int32_t), 3, f) != 3 || fread(&cout, sizeof(double), 1, f) != 1
+            || champs[0] < 0 || champs[0] >= entete[0] || champs[1] < 0 || champs[1] >= entete[1] || champs[2] < 0
+            || !ajouterCaseBase(s, champs[0], champs[1], champs[2], cout)) {
+            libererSolutionCreuse(s);
+            s = NULL;
         }
     }
-
-    free(visite);
-    libererQueue(q);
-    return connexe;
+    // Version 2 : potentiels optionnels après les cases
+    int32_t a_duale = 0;
+    if (s && version >= 2 && (fread(&a_duale, sizeof(int32_t), 1, f) != 1 || a_duale < 0 || a_duale > 1)) {
+        libererSolutionCreuse(s);
+        s = NULL;
+    }
+    if (s && a_duale) {
+        s->E_s = (double*)malloc(s->n * sizeof(double));
+        s->E_t = (double*)malloc(s->m * sizeof(double));
+        if (!s->E_s || !s->E_t
+            || fread(s->E_s, sizeof(double), s->n, f) != (size_t)s->n
+            || fread(s->E_t, sizeof(double), s->m, f) != (size_t)s->m) {
+            libererSolutionCreuse(s);
+            s = NULL;
+        }
+    }
+    return s;
 }
 
-bool testerEtResoudreDegenerescence(ProblemeTransport* p, int** base) {
-    int n = p->n, m = p->m;
-    int nb_aretes = 0;
-    for(int i=0; i<n; i++)
-        for(int j=0; j<m; j++)
-            if(base[i][j]) nb_aretes++;
-
-    int requis = n + m - 1;
+SolutionCreuse* lireSolutionBinaire(const char* nomFichier) {
+    FILE* f = fopen(nomFichier, "rb");
+    if (!f) return NULL;
+    SolutionCreuse* s = lireSolutionBinaireFlux(f);
+    fclose(f);
+    return s;
+}
 
-    printf("\n[TEST DEGENERESCENCE] Aretes de base : %d/%d\n", nb_aretes, requis);
+// =========================================================================
+// 5. TRACE STRUCTUREE DU MARCHE-PIED
+// =========================================================================
 
-    if (nb_aretes >= requis) {
-        bool connexe = testerConnexite(p, base);
-        if (connexe) {
-            printf(">>> Base complete et connexe.\n");
-        }
-        return false;
+/**
+ * @brief Remplit une solution creuse à partir de la base courante (y compris les cases dégénérées).
+ * Si s est NULL, une nouvelle solution est allouée ; sinon elle est vidée et réutilisée.
+ * En cas d'échec d'allocation, s est libérée et NULL est renvoyé (jamais de solution tronquée).
+ */
+static SolutionCreuse* remplirSolutionDepuisBase(ProblemeTransport* p, const BaseBinaire* base, SolutionCreuse* s) {
+    if (!s) s = creerSolutionCreuse(p->n, p->m);
+    if (!s) return NULL;
+    // Les cases hors base à leur capacité (problème capacité) font partie de la solution
+    int nb = 0;
+    for (int i = 0; i < p->n; i++)
+        for (int j = 0; j < p->m; j++)
+            if (estDeBase(base, i, j) || p->B[i][j] > 0) nb++;
+    // Place réservée avant de vider s : le remplissage ne peut plus échouer
+    if (nb > s->capacite) {
+        CaseBase* tmp = (CaseBase*)realloc(s->cases, nb * sizeof(CaseBase));
+        if (!tmp) { libererSolutionCreuse(s); return NULL; }
+        s->cases = tmp;
+        s->capacite = nb;
     }
+    s->nb_cases = 0;
+    s->cout_total = 0.0;
+    for (int i = 0; i < p->n; i++)
+        for (int j = 0; j < p->m; j++)
+            if (estDeBase(base, i, j) || p->B[i][j] > 0) ajouterCaseBase(s, i, j, p->B[i][j], p->A[i][j]);
+    return s;
+}
 
-    printf(">>> Base incomplete. Ajout de variables artificielles...\n");
+// Identifiant et version du format binaire de trace
+static const char MAGIC_TRACE[4] = { 'R', 'O', 'T', 'R' };
+#define VERSION_FORMAT_TRACE 1u
+
+// Types d'enregistrement de la trace binaire
+#define TRACE_EVT_ITERATION 'I'
+#define TRACE_EVT_FIN       'F'
+
+void optionsMarchePiedParDefaut(OptionsMarchePied* o) {
+    o->max_iterations = 5000;
+    o->max_stagnation = 1000; // Garde-fou : la règle de Bland exclut déjà le cyclage
+    o->trace = NULL;
+    o->pool = NULL;
+    o->resultat = NULL;
+    o->annulation = NULL;
+    o->delai_max = 0.0;
+    o->compteurs = NULL;
+}
 
-    testerConnexite(p, base);
+/**
+ * @brief Indique si l'itération doit être tracée au niveau demandé (échantillonnage 1 sur k).
+ */
+static bool iterationTracee(const TraceMarchePied* t, NiveauTrace niveau, int iter) {
+    if (!t || t->niveau < niveau) return false;
+    int k = (t->echantillonnage > 1) ? t->echantillonnage : 1;
+    return (iter - 1) % k == 0;
+}
 
-    int ajouts = 0;
-    for(int i=0; i<n && nb_aretes < requis; i++) {
-        for(int j=0; j<m && nb_aretes < requis; j++) {
-            if (!base[i][j]) {
-                if (!cheminExiste(n, m, base, i, n + j)) {
-                    base[i][j] = 1;
-                    nb_aretes++;
-                    ajouts++;
-                    printf("  + Arete artificielle : (%d, %d)\n", i, j);
-                }
-            }
+static void traceDebut(const TraceMarchePied* t, ProblemeTransport* p, double cout) {
+    if (!t || t->niveau < TRACE_RESUME) return;
+    switch (t->format) {
+        case TRACE_CONSOLE:
+            printf("\n\n=== METHODE DU MARCHE-PIED ===\n");
+            break;
+        case TRACE_JSONL:
+            fprintf(t->flux, "{\"evt\":\"debut\",\"n\":%d,\"m\":%d,\"cout\":%.15g}\n",
+                    p->n, p->m, cout);
+            break;
+        case TRACE_BINAIRE: {
+            uint32_t version = VERSION_FORMAT_TRACE;
+            int32_t dims[2] = { p->n, p->m };
+            fwrite(MAGIC_TRACE, 1, 4, t->flux);
+            fwrite(&version, sizeof(version), 1, t->flux);
+            fwrite(dims, sizeof(int32_t), 2, t->flux);
+            break;
         }
     }
+}
 
-    printf(">>> %d arete(s) ajoutee(s).\n", ajouts);
-
-    return true;
+/**
+ * @brief Écrit un enregistrement binaire : type (u8), iter, i, j, theta (i32), gain, valeur (f64).
+ */
+static void traceEnregistrementBinaire(FILE* f, char type, int iter, int i, int j, int theta,
+                                       double gain, double valeur) {
+    uint8_t t8 = (uint8_t)type;
+    int32_t champs[4] = { iter, i, j, theta };
+    double reels[2] = { gain, valeur };
+    fwrite(&t8, 1, 1, f);
+    fwrite(champs, sizeof(int32_t), 4, f);
+    fwrite(reels, sizeof(double), 2, f);
 }
 
-void calculerPotentiels(ProblemeTransport* p, int** base, double* E_s, double* E_t) {
-    for(int i=0; i<p->n; i++) E_s[i] = DBL_MAX;
-    for(int j=0; j<p->m; j++) E_t[j] = DBL_MAX;
+/**
+ * @brief Trace un pivot : case entrante, coût marginal, theta et variation du coût (theta * gain).
+ * Au niveau détaillé JSONL, ajoute les potentiels et la base (taille O(n+m)).
+ */
+static void traceIteration(const TraceMarchePied* t, ProblemeTransport* p, const BaseBinaire* base,
+                           int iter, int i_in, int j_in, double gain, int theta,
+                           double* E_s, double* E_t) {
+    switch (t->format) {
+        case TRACE_CONSOLE:
+            printf("Iteration %d : entrante (%d, %d) gain=%.2f theta=%d variation=%.2f\n",
+                   iter, i_in, j_in, gain, theta, gain * theta);
+            break;
+        case TRACE_JSONL:
+            fprintf(t->flux, "{\"evt\":\"iter\",\"iter\":%d,\"i\":%d,\"j\":%d,\"gain\":%.15g,"
+                    "\"theta\":%d,\"variation\":%.15g", iter, i_in, j_in, gain, theta, gain * theta);
+            if (t->niveau >= TRACE_DETAILLEE) {
+                fprintf(t->flux, ",\"Es\":[");
+                for (int i = 0; i < p->n; i++) fprintf(t->flux, "%s%.15g", i ? "," : "", E_s[i]);
+                fprintf(t->flux, "],\"Et\":[");
+                for (int j = 0; j < p->m; j++) fprintf(t->flux, "%s%.15g", j ? "," : "", E_t[j]);
+                fprintf(t->flux, "],\"base\":[");
+                bool premier = true;
+                for (int i = 0; i < p->n; i++)
+                    for (int j = 0; j < p->m; j++)
+                        if (estDeBase(base, i, j)) {
+                            fprintf(t->flux, "%s[%d,%d,%d]", premier ? "" : ",", i, j, p->B[i][j]);
+                            premier = false;
+                        }
+                fprintf(t->flux, "]");
+            }
+            fprintf(t->flux, "}\n");
+            break;
+        case TRACE_BINAIRE:
+            traceEnregistrementBinaire(t->flux, TRACE_EVT_ITERATION, iter, i_in, j_in, theta,
+                                       gain, gain * theta);
+            break;
+    }
+}
 
-    Queue* q = creerQueue(p->n + p->m);
+static void traceFin(const TraceMarchePied* t, int iter, bool optimal, double cout) {
+    if (!t || t->niveau < TRACE_RESUME) return;
+    switch (t->format) {
+        case TRACE_CONSOLE:
+            if (optimal) printf("\n>>> SOLUTION OPTIMALE (Iteration %d)\n", iter);
+            else printf("\n>>> ARRET SANS PREUVE D'OPTIMALITE (Iteration %d)\n", iter);
+            printf("\n=== FIN MARCHE-PIED ===\n\n");
+            break;
+        case TRACE_JSONL:
+            fprintf(t->flux, "{\"evt\":\"fin\",\"iter\":%d,\"optimal\":%s,\"cout\":%.15g}\n",
+                    iter, optimal ? "true" : "false", cout);
+            break;
+        case TRACE_BINAIRE:
+            traceEnregistrementBinaire(t->flux, TRACE_EVT_FIN, iter, -1, -1, optimal ? 1 : 0, 0.0, cout);
+            break;
+    }
+    fflush(t->flux);
+}
 
-    E_s[0] = 0.0;
-    enqueue(q, 0, -1);
+// =========================================================================
+// 6. TRIS DES COUTS (METHODES INITIALES)
+// =========================================================================
 
-    while(!isQueueEmpty(q)) {
-        int u = dequeue(q).index;
-        if (u < p->n) {
-            for (int j = 0; j < p->m; j++) {
-                if (base[u][j] && E_t[j] == DBL_MAX) {
-                    E_t[j] = E_s[u] - p->A[u][j];
-                    enqueue(q, p->n + j, u);
-                }
-            }
-        } else {
-            int j = u - p->n;
-            for (int i = 0; i < p->n; i++) {
-                if (base[i][j] && E_s[i] == DBL_MAX) {
-                    E_s[i] = p->A[i][j] + E_t[j];
-                    enqueue(q, i, u);
-                }
-            }
-        }
-    }
-    libererQueue(q);
+// Ordre croissant des coûts, départage par indice croissant (résultat déterministe)
+static int comparerCoupleCroissant(const void* a, const void* b) {
+    const CoupleCout* x = (const CoupleCout*)a;
+    const CoupleCout* y = (const CoupleCout*)b;
+    if (x->cout < y->cout) return -1;
+    if (x->cout > y->cout) return 1;
+    return (x->indice > y->indice) - (x->indice < y->indice);
 }
 
-bool calculerCoutsMarginaux(ProblemeTransport* p, int** base, double* E_s, double* E_t,
-                            int* i_ajout, int* j_ajout, double** couts_marginaux) {
-    double meilleur_gain = -EPSILON;
-    *i_ajout = -1; *j_ajout = -1;
-    bool amelioration = false;
+/**
+ * @brief Trie une ligne ou une colonne (taille cases) et range les indices triés, sur 16 ou 32 bits.
+ */
+static void rangerOrdre(CoupleCout* tmp, int taille, bool compact, void* dest, long decalage) {
+    qsort(tmp, taille, sizeof(CoupleCout), comparerCoupleCroissant);
+    if (compact) for (int k = 0; k < taille; k++) ((uint16_t*)dest)[decalage + k] = (uint16_t)tmp[k].indice;
+    else for (int k = 0; k < taille; k++) ((uint32_t*)dest)[decalage + k] = tmp[k].indice;
+}
 
-    for (int i = 0; i < p->n; i++) {
+/**
+ * @brief Trie toutes les cases (indice i*m + j) par coût croissant.
+ * @return Tableau de n*m indices (à libérer), NULL en cas d'erreur d'allocation.
+ */
+static uint32_t* trierCasesParCout(const ProblemeTransport* p) {
+    long nb = (long)p->n * p->m;
+    if ((unsigned long)nb > UINT32_MAX) return NULL; // Indices de case codés sur 32 bits
+    CoupleCout* cases = (CoupleCout*)malloc(nb * sizeof(CoupleCout));
+    uint32_t* ordre = (uint32_t*)malloc(nb * sizeof(uint32_t));
+    if (!cases || !ordre) { free(cases); free(ordre); return NULL; }
+    for (int i = 0; i < p->n; i++)
         for (int j = 0; j < p->m; j++) {
-            if (base[i][j]) {
-                couts_marginaux[i][j] = 0.0;
-            } else {
-                double delta = p->A[i][j] - (E_s[i] - E_t[j]);
-                couts_marginaux[i][j] = delta;
-
-                if (delta < meilleur_gain) {
-                    meilleur_gain = delta;
-                    *i_ajout = i;
-                    *j_ajout = j;
-                    amelioration = true;
-                }
-            }
+            cases[(long)i * p->m + j].cout = p->A[i][j];
+            cases[(long)i * p->m + j].indice = (uint32_t)i * (uint32_t)p->m + (uint32_t)j;
         }
-    }
-    return amelioration;
+    qsort(cases, nb, sizeof(CoupleCout), comparerCoupleCroissant);
+    for (long k = 0; k < nb; k++) ordre[k] = cases[k].indice;
+    free(cases);
+    return ordre;
 }
 
-void trouverEtResoudreCycle(ProblemeTransport* p, int** base, int i_ajout, int j_ajout) {
+OrdresCouts* calculerOrdresCouts(const ProblemeTransport* p, bool avec_global) {
     int n = p->n, m = p->m;
-    Queue* q = creerQueue(n + m);
-    int* parent = (int*)malloc((n + m) * sizeof(int));
-    bool* visite = (bool*)calloc(n + m, sizeof(bool));
+    OrdresCouts* o = (OrdresCouts*)calloc(1, sizeof(OrdresCouts));
+    CoupleCout* tmp = (CoupleCout*)malloc((n > m ? n : m) * sizeof(CoupleCout));
+    if (o) {
+        o->n = n; o->m = m;
+        o->compact = (n <= 65536 && m <= 65536);
+        size_t taille = o->compact ? sizeof(uint16_t) : sizeof(uint32_t);
+        o->lignes = malloc((size_t)n * m * taille);
+        o->colonnes = malloc((size_t)n * m * taille);
+        if (avec_global) o->global = trierCasesParCout(p);
+    }
+    if (!o || !tmp || !o->lignes || !o->colonnes || (avec_global && !o->global)) {
+        free(tmp);
+        libererOrdresCouts(o);
+        return NULL;
+    }
 
-    int start = n + j_ajout;
-    int target = i_ajout;
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < m; j++) { tmp[j].cout = p->A[i][j]; tmp[j].indice = j; }
+        rangerOrdre(tmp, m, o->compact, o->lignes, (long)i * m);
+    }
+    for (int j = 0; j < m; j++) {
+        const double* colonne = colonneCouts(p, j);
+        for (int i = 0; i < n; i++) { tmp[i].cout = colonne ? colonne[i] : p->A[i][j]; tmp[i].indice = i; }
+        rangerOrdre(tmp, n, o->compact, o->colonnes, (long)j * n);
+    }
+    free(tmp);
+    return o;
+}
 
-    enqueue(q, start, -1);
-    visite[start] = true;
-    bool found = false;
+void libererOrdresCouts(OrdresCouts* o) {
+    if (o) { free(o->lignes); free(o->colonnes); free(o->global); free(o); }
+}
 
-    while(!isQueueEmpty(q)) {
-        int u = dequeue(q).index;
-        if (u == target) { found = true; break; }
-        if (u < n) {
-            for (int j = 0; j < m; j++) if (base[u][j] && !visite[n + j]) {
-                visite[n + j] = true; parent[n + j] = u; enqueue(q, n + j, u);
-            }
-        } else {
-            for (int i = 0; i < n; i++) if (base[i][u - n] && !visite[i]) {
-                visite[i] = true; parent[i] = u; enqueue(q, i, u);
-            }
-        }
+const OrdresCouts* ordresCouts(ProblemeTransport* p, bool avec_global) {
+    if (p->ordres && (!avec_global || p->ordres->global)) return p->ordres;
+    if (p->ordres && p->ordres_possedes) {
+        // Cache propre sans ordre global : seul l'ordre global est ajouté
+        p->ordres->global = trierCasesParCout(p);
+        return p->ordres->global ? p->ordres : NULL;
     }
+    OrdresCouts* o = calculerOrdresCouts(p, avec_global);
+    if (!o) return NULL;
+    invaliderOrdresCouts(p);
+    p->ordres = o;
+    p->ordres_possedes = true;
+    return o;
+}
 
-    if (found) {
-        // AFFICHAGE DU CYCLE
-        int* cycle_sommets = (int*)malloc((n + m) * sizeof(int));
-        int cycle_len = 0;
+void invaliderOrdresCouts(ProblemeTransport* p) {
+    if (p->ordres_possedes) libererOrdresCouts(p->ordres);
+    p->ordres = NULL;
+    p->ordres_possedes = false;
+}
 
-        int curr = target;
-        while(curr != start) {
-            cycle_sommets[cycle_len++] = curr;
-            curr = parent[curr];
-        }
-        cycle_sommets[cycle_len++] = start;
-
-        printf("\n[CYCLE DETECTE] : ");
-        for(int k = cycle_len - 1; k >= 0; k--) {
-            int s = cycle_sommets[k];
-            if (s < n) printf("F%d", s);
-            else printf("C%d", s - n);
-            if (k > 0) printf(" -> ");
-        }
-        printf("\n");
+/**
+ * @brief Indique si la case (i, j) a atteint sa capacité (toujours faux sans capacités).
+ */
+static bool casePleine(const ProblemeTransport* p, int i, int j) {
+    return p->U && p->B[i][j] >= capaciteCase(p, i, j);
+}
 
-        free(cycle_sommets);
-
-        // CALCUL THETA
-        double theta = DBL_MAX;
-        int i_out = -1, j_out = -1;
-
-        curr = target;
-        bool is_neg = true;
-
-        printf("\n[MAXIMISATION] Conditions :\n");
-
-        while(curr != start) {
-            int par = parent[curr];
-            int r, c;
-            if (curr < n) { r = curr; c = par - n; }
-            else { r = par; c = curr - n; }
-
-            if (is_neg) {
-                int val = p->B[r][c];
-                printf("  Case (%d,%d) : Flux=%d", r, c, val);
-
-                if (val < theta) {
-                    theta = val;
-                    i_out = r; j_out = c;
-                    printf(" <- LIMITANT");
-                } else if (fabs(val - theta) < EPSILON && i_out != -1) {
-                    int current_id = r * m + c;
-                    int best_id = i_out * m + j_out;
-                    if (current_id < best_id) {
-                        i_out = r; j_out = c;
-                        printf(" <- LIMITANT (Bland)");
-                    }
+/**
+ * @brief Achemine l'offre et la demande restantes (P, C) par chemins augmentants après une méthode
+ * initiale capacitée. Parcours BFS depuis les fournisseurs excédentaires : F_i -> C_j si la case n'est
+ * pas pleine, C_j -> F_i si elle n'est pas vide ; arrêt sur un client en déficit.
+ * @return false si le problème est irréalisable avec ces capacités.
+ */
+static bool completerSolutionCapacitee(ProblemeTransport* p, int* P, int* C) {
+    int n = p->n, m = p->m;
+    int* parent = (int*)malloc((n + m) * sizeof(int));
+    Queue* q = creerQueue(n + m);
+    bool realisable = parent && q;
+
+    while (realisable) {
+        for (int u = 0; u < n + m; u++) parent[u] = -2; // -2 : non visité, -1 : source
+        q->front = 0; q->rear = -1;
+        for (int i = 0; i < n; i++) if (P[i] > 0) { parent[i] = -1; enqueue(q, i, -1); }
+        if (isQueueEmpty(q)) break; // Plus d'offre restante
+
+        int cible = -1;
+        while (!isQueueEmpty(q) && cible < 0) {
+            int u = dequeue(q).index;
+            if (u < n) {
+                for (int j = 0; j < m; j++) {
+                    if (parent[n + j] != -2 || casePleine(p, u, j)) continue;
+                    parent[n + j] = u;
+                    if (C[j] > 0) { cible = n + j; break; }
+                    enqueue(q, n + j, u);
                 }
-                printf("\n");
-            }
-            is_neg = !is_neg;
-            curr = par;
-        }
-
-        printf("\n>>> Theta (transfert) = %.0f\n", theta);
-
-        // === AMÉLIORATION 2 : GESTION θ = 0 ===
-        if (fabs(theta) < EPSILON) {
-            printf("\n[ALERTE] Theta = 0 (Degenerescence cyclique)\n");
-            printf(">>> Conservation de l'arete ameliorante (%d, %d)\n", i_ajout, j_ajout);
-            printf(">>> Suppression des aretes artificielles (flux nul)...\n");
-
-            // Marquer l'arête améliorante
-            base[i_ajout][j_ajout] = 1;
-
-            // Supprimer TOUTES les arêtes artificielles (B[i][j] == 0)
-            int nb_supprimees = 0;
-            for(int i=0; i<n; i++) {
-                for(int j=0; j<m; j++) {
-                    if (base[i][j] && p->B[i][j] == 0 && !(i == i_ajout && j == j_ajout)) {
-                        base[i][j] = 0;
-                        nb_supprimees++;
-                        printf("  - Arete artificielle supprimee : (%d, %d)\n", i, j);
-                    }
+            } else {
+                for (int i = 0; i < n; i++) {
+                    if (parent[i] != -2 || p->B[i][u - n] == 0) continue;
+                    parent[i] = u;
+                    enqueue(q, i, u);
                 }
             }
-
-            printf(">>> %d arete(s) artificielle(s) supprimee(s).\n", nb_supprimees);
-            printf(">>> Le prochain test de connexite proposera de nouvelles aretes.\n");
-
-            free(parent); free(visite); libererQueue(q);
-            return;
         }
-
-        // MISE A JOUR NORMALE (θ > 0)
-        p->B[i_ajout][j_ajout] += (int)theta;
-        base[i_ajout][j_ajout] = 1;
-
-        curr = target;
-        is_neg = true;
-        while(curr != start) {
-            int par = parent[curr];
-            int r, c;
-            if (curr < n) { r = curr; c = par - n; }
-            else { r = par; c = curr - n; }
-
-            if (is_neg) p->B[r][c] -= (int)theta;
-            else p->B[r][c] += (int)theta;
-            is_neg = !is_neg;
-            curr = par;
+        if (cible < 0) { realisable = false; break; }
+
+        // Quantité transférable : limitée par l'offre, la demande et chaque case du chemin
+        int v = cible, source = cible;
+        int quantite = C[cible - n];
+        while (parent[v] != -1) {
+            int u = parent[v];
+            int marge = (u < n) ? capaciteCase(p, u, v - n) - p->B[u][v - n] : p->B[v][u - n];
+            if (marge < quantite) quantite = marge;
+            v = u;
         }
+        source = v;
+        if (P[source] < quantite) quantite = P[source];
 
-        if (i_out != -1) {
-            printf("\n[SORTIE DE BASE] Arete supprimee : (%d, %d)\n", i_out, j_out);
-            base[i_out][j_out] = 0;
+        for (v = cible; parent[v] != -1; v = parent[v]) {
+            int u = parent[v];
+            if (u < n) p->B[u][v - n] += quantite;
+            else p->B[v][u - n] -= quantite;
         }
+        P[source] -= quantite;
+        C[cible - n] -= quantite;
     }
-    free(parent); free(visite); libererQueue(q);
+
+    free(parent); libererQueue(q);
+    return realisable;
 }
 
-void algoMarchePied(ProblemeTransport* p) {
-    int n = p->n, m = p->m;
-    int** base = (int**)malloc(n * sizeof(int*));
-    double** couts_marginaux = (double**)malloc(n * sizeof(double*));
-    for(int i=0; i<n; i++) {
-        base[i] = (int*)calloc(m, sizeof(int));
-        couts_marginaux[i] = (double*)calloc(m, sizeof(double));
-    }
-    double* E_s = (double*)malloc(n * sizeof(double));
-    double* E_t = (double*)malloc(m * sizeof(double));
-
-    for(int i=0; i<n; i++)
-        for(int j=0; j<m; j++)
-            if (p->B[i][j] > 0) base[i][j] = 1;
-
-    int iter = 0;
-    bool optimal = false;
-
-    printf("\n\n=== METHODE DU MARCHE-PIED ===\n");
-
-    while (!optimal && iter < 1000) {
-        iter++;
-        printf("\n========== ITERATION %d ==========\n", iter);
-
-        testerEtResoudreDegenerescence(p, base);
-        calculerPotentiels(p, base, E_s, E_t);
-        afficherTableauPotentiels(p, E_s, E_t);
-
-        int i_in, j_in;
-        bool possible = calculerCoutsMarginaux(p, base, E_s, E_t, &i_in, &j_in, couts_marginaux);
-        afficherTableauMarginaux(p, couts_marginaux, base);
-
-        if (!possible) {
-            optimal = true;
-            printf("\n>>> SOLUTION OPTIMALE (Iteration %d)\n", iter);
-        } else {
-            printf("\n[AMELIORATION] Arete entrante : (%d, %d) [Gain=%.2f]\n",
-                   i_in, j_in, couts_marginaux[i_in][j_in]);
-            trouverEtResoudreCycle(p, base, i_in, j_in);
-            afficherTableauSolution(p);
-            printf("\n>>> Cout apres iteration %d : %.2f\n", iter, calculerCoutTotal(p));
+/**
+ * @brief Base initiale d'un problème capacité : cases non vides et non pleines. Une case qui fermerait
+ * un cycle est pivotée le long de ce cycle jusqu'à ce qu'une case atteigne une borne (0 ou U) :
+ * la base reste une forêt, les cases hors base sont à 0 ou à leur capacité.
+ */
+static void initialiserBaseCapacitee(ProblemeTransport* p, BaseBinaire* base) {
+    for (int i = 0; i < p->n; i++) {
+        for (int j = 0; j < p->m; j++) {
+            if (p->B[i][j] == 0 || casePleine(p, i, j)) continue;
+            if (!cheminExiste(base, i, p->n + j)) ajouterDeBase(base, i, j);
+            else trouverEtResoudreCycleSilencieux(p, base, i, j);
         }
     }
+}
 
-    printf("\n=== FIN MARCHE-PIED ===\n\n");
+/**
+ * @brief Deux plus petits coûts actifs de la ligne i (colonne saturée ou case pleine : inactive).
+ * premier / second sont les positions des deux premiers actifs dans l'ordre trié ; les cases inactives
+ * le restent, donc ces positions ne reculent jamais : avance amortie O(1) sur toute la méthode.
+ */
+static void deuxMinimaLigne(const ProblemeTransport* p, const OrdresCouts* o, const int* col_sat, int i,
+                            int* premier, int* second, double* m1, double* m2) {
+    int m = p->m, k = *premier;
+    while (k < m && (col_sat[ordreLigne(o, i, k)] || casePleine(p, i, ordreLigne(o, i, k)))) k++;
+    *premier = k;
+    int k2 = (*second > k) ? *second : k + 1;
+    while (k2 < m && (col_sat[ordreLigne(o, i, k2)] || casePleine(p, i, ordreLigne(o, i, k2)))) k2++;
+    *second = k2;
+    *m1 = (k < m) ? p->A[i][ordreLigne(o, i, k)] : DBL_MAX;
+    *m2 = (k2 < m) ? p->A[i][ordreLigne(o, i, k2)] : DBL_MAX;
+}
 
-    for(int i=0; i<n; i++) { free(base[i]); free(couts_marginaux[i]); }
-    free(base); free(couts_marginaux); free(E_s); free(E_t);
+/**
+ * @brief Deux plus petits coûts actifs de la colonne j (voir deuxMinimaLigne).
+ */
+static void deuxMinimaColonne(const ProblemeTransport* p, const OrdresCouts* o, const int* row_sat, int j,
+                              int* premier, int* second, double* m1, double* m2) {
+    int n = p->n, k = *premier;
+    while (k < n && (row_sat[ordreColonne(o, j, k)] || casePleine(p, ordreColonne(o, j, k), j))) k++;
+    *premier = k;
+    int k2 = (*second > k) ? *second : k + 1;
+    while (k2 < n && (row_sat[ordreColonne(o, j, k2)] || casePleine(p, ordreColonne(o, j, k2), j))) k2++;
+    *second = k2;
+    const double* colonne = colonneCouts(p, j);
+    if (k < n) *m1 = colonne ? colonne[ordreColonne(o, j, k)] : p->A[ordreColonne(o, j, k)][j];
+    else *m1 = DBL_MAX;
+    if (k2 < n) *m2 = colonne ? colonne[ordreColonne(o, j, k2)] : p->A[ordreColonne(o, j, k2)][j];
+    else *m2 = DBL_MAX;
 }
 
+// =========================================================================
+// 7. SPECIALISATIONS AFFICHEE / SILENCIEUSE
+// =========================================================================
 
+// Version affichée : algoNordOuest, algoBalasHammer, testerConnexite, ...
+#define OBSERVATEUR_ACTIF 1
+#define SPECIALISER(nom) nom
+#include "projet_ro_algos.inc"
+#undef OBSERVATEUR_ACTIF
+#undef SPECIALISER
+
+// Version silencieuse : algoNordOuestSilencieux, ... (aucun code d'affichage compilé)
+#define OBSERVATEUR_ACTIF 0
+#define SPECIALISER(nom) nom##Silencieux
+#include "projet_ro_algos.inc"
+#undef OBSERVATEUR_ACTIF
+#undef SPECIALISER
 
-/**
- * @brief Version du Marche-Pied pour l'étude de complexité.
- * Cette fonction est nécessaire pour que etude_complexite.c puisse compiler.
- */
 // =========================================================================
-// VERSIONS SILENCIEUSES POUR L'ÉTUDE DE COMPLEXITE (SANS PRINTF)
+// 8. SELECTION DE LA METHODE INITIALE
 // =========================================================================
 
-// 1. Connexité Silencieuse
-bool testerConnexiteSilencieux(ProblemeTransport* p, int** base) {
-    int n = p->n, m = p->m;
-    int total = n + m;
-    bool* visite = (bool*)calloc(total, sizeof(bool));
-    Queue* q = creerQueue(total);
+static const char* const NOMS_METHODES[NB_METHODES_INITIALES] = {
+    "Nord-Ouest", "Balas-Hammer", "Russell", "Moindre cout"
+};
+static const char* const ABREVIATIONS_METHODES[NB_METHODES_INITIALES] = { "NO", "BH", "RU", "MC" };
 
-    enqueue(q, 0, -1);
-    visite[0] = true;
-    int nb_visites = 1;
+const char* nomMethodeInitiale(MethodeInitiale methode) {
+    return (methode >= 0 && methode < NB_METHODES_INITIALES) ? NOMS_METHODES[methode] : "?";
+}
 
-    while(!isQueueEmpty(q)) {
-        int u = dequeue(q).index;
-        if (u < n) {
-            for (int j = 0; j < m; j++) {
-                if (base[u][j] && !visite[n + j]) {
-                    visite[n + j] = true;
-                    nb_visites++;
-                    enqueue(q, n + j, u);
-                }
-            }
-        } else {
-            for (int i = 0; i < n; i++) {
-                if (base[i][u - n] && !visite[i]) {
-                    visite[i] = true;
-                    nb_visites++;
-                    enqueue(q, i, u);
-                }
-            }
-        }
-    }
-    free(visite);
-    libererQueue(q);
-    return (nb_visites == total);
+const char* abreviationMethodeInitiale(MethodeInitiale methode) {
+    return (methode >= 0 && methode < NB_METHODES_INITIALES) ? ABREVIATIONS_METHODES[methode] : "?";
 }
 
-// 2. Dégénérescence Silencieuse
-bool testerEtResoudreDegenerescenceSilencieux(ProblemeTransport* p, int** base) {
-    int n = p->n, m = p->m;
-    int nb_aretes = 0;
-    for(int i=0; i<n; i++)
-        for(int j=0; j<m; j++)
-            if(base[i][j]) nb_aretes++;
-
-    int requis = n + m - 1;
-
-    if (nb_aretes >= requis) {
-        // Juste vérifier la connexité sans rien afficher
-        if (testerConnexiteSilencieux(p, base)) return false;
-    }
-
-    // Réparation silencieuse
-    testerConnexiteSilencieux(p, base);
-    for(int i=0; i<n && nb_aretes < requis; i++) {
-        for(int j=0; j<m && nb_aretes < requis; j++) {
-            if (!base[i][j]) {
-                if (!cheminExiste(n, m, base, i, n + j)) {
-                    base[i][j] = 1;
-                    nb_aretes++;
-                }
-            }
-        }
-    }
+bool lireMethodeInitiale(const char* texte, MethodeInitiale* methode) {
+    if (strcmp(texte, "no") == 0) *methode = METHODE_NORD_OUEST;
+    else if (strcmp(texte, "bh") == 0) *methode = METHODE_BALAS_HAMMER;
+    else if (strcmp(texte, "ru") == 0 || strcmp(texte, "russell") == 0) *methode = METHODE_RUSSELL;
+    else if (strcmp(texte, "mc") == 0) *methode = METHODE_MOINDRE_COUT;
+    else return false;
     return true;
 }
 
-// 3. Cycle Silencieux (avec gestion du Theta=0)
-// Retourne TRUE si une modification a été faite, FALSE si Theta=0 (stalling)
-bool trouverEtResoudreCycleSilencieux(ProblemeTransport* p, int** base, int i_ajout, int j_ajout) {
-    int n = p->n, m = p->m;
-    Queue* q = creerQueue(n + m);
-    int* parent = (int*)malloc((n + m) * sizeof(int));
-    bool* visite = (bool*)calloc(n + m, sizeof(bool));
-
-    int start = n + j_ajout;
-    int target = i_ajout;
-
-    enqueue(q, start, -1);
-    visite[start] = true;
-    bool found = false;
-
-    while(!isQueueEmpty(q)) {
-        int u = dequeue(q).index;
-        if (u == target) { found = true; break; }
-        if (u < n) {
-            for (int j = 0; j < m; j++) if (base[u][j] && !visite[n + j]) {
-                visite[n + j] = true; parent[n + j] = u; enqueue(q, n + j, u);
-            }
-        } else {
-            for (int i = 0; i < n; i++) if (base[i][u - n] && !visite[i]) {
-                visite[i] = true; parent[i] = u; enqueue(q, i, u);
-            }
-        }
+double appliquerMethodeInitiale(ProblemeTransport* p, MethodeInitiale methode, bool affichage) {
+    switch (methode) {
+        case METHODE_NORD_OUEST:
+            return affichage ? algoNordOuest(p) : algoNordOuestSilencieux(p);
+        case METHODE_BALAS_HAMMER:
+            return affichage ? algoBalasHammer(p) : algoBalasHammerSilencieux(p);
+        case METHODE_RUSSELL:
+            return affichage ? algoRussell(p) : algoRussellSilencieux(p);
+        case METHODE_MOINDRE_COUT:
+            return affichage ? algoMoindreCout(p) : algoMoindreCoutSilencieux(p);
+        default:
+            return 0.0;
     }
+}
 
-    if (found) {
-        double theta = DBL_MAX;
-        int i_out = -1, j_out = -1;
-        int curr = target;
-        bool is_neg = true;
-
-        // Calcul Theta
-        while(curr != start) {
-            int par = parent[curr];
-            int r, c;
-            if (curr < n) { r = curr; c = par - n; } else { r = par; c = curr - n; }
-
-            if (is_neg) {
-                int val = p->B[r][c];
-                if (val < theta) {
-                    theta = val;
-                    i_out = r; j_out = c;
-                } else if (val == theta && i_out != -1) {
-                    // Bland
-                    if (r * m + c < i_out * m + j_out) { i_out = r; j_out = c; }
-                }
-            }
-            is_neg = !is_neg;
-            curr = par;
-        }
+// =========================================================================
+// 9. POINTS D'ENTREE DU MARCHE-PIED
+// =========================================================================
 
-        // Cas Theta = 0
-        if (theta < EPSILON) {
-            base[i_ajout][j_ajout] = 1;
-            // Suppression des arêtes artificielles sauf celle qu'on vient d'ajouter
-            for(int i=0; i<n; i++) {
-                for(int j=0; j<m; j++) {
-                    if (base[i][j] && p->B[i][j] == 0 && !(i == i_ajout && j == j_ajout)) {
-                        base[i][j] = 0;
-                    }
-                }
-            }
-            free(parent); free(visite); libererQueue(q);
-            return false; // Indique un pas dégénéré
-        }
+SolutionCreuse* algoMarchePiedOptions(ProblemeTransport* p, const OptionsMarchePied* o) {
+    // Sans trace, la version silencieuse est utilisée : aucun test de niveau dans la boucle
+    if (o->trace && o->trace->niveau > TRACE_AUCUNE) return marchePiedCoeur(p, o);
+    return marchePiedCoeurSilencieux(p, o);
+}
 
-        // Mise à jour normale
-        p->B[i_ajout][j_ajout] += (int)theta;
-        base[i_ajout][j_ajout] = 1;
-
-        curr = target;
-        is_neg = true;
-        while(curr != start) {
-            int par = parent[curr];
-            int r, c;
-            if (curr < n) { r = curr; c = par - n; } else { r = par; c = curr - n; }
-            if (is_neg) p->B[r][c] -= (int)theta;
-            else p->B[r][c] += (int)theta;
-            is_neg = !is_neg;
-            curr = par;
-        }
+const char* nomCauseArret(CauseArret cause) {
+    static const char* NOMS[] = { "optimal", "iterations", "stagnation", "delai", "annulation", "irrealisable" };
+    return ((int)cause >= 0 && cause <= ARRET_IRREALISABLE) ? NOMS[cause] : "?";
+}
 
-        if (i_out != -1) base[i_out][j_out] = 0;
+SolutionCreuse* resoudreAnytime(ProblemeTransport* p, MethodeInitiale methode,
+                                const OptionsMarchePied* o, ResultatMarchePied* resultat) {
+    double debut = horlogeMurale();
+    OptionsMarchePied options;
+    if (o) options = *o;
+    else optionsMarchePiedParDefaut(&options);
+    options.resultat = resultat;
+
+    appliquerMethodeInitiale(p, methode, false);
+    if (options.delai_max > 0.0) {
+        // Le délai restant ne peut pas être nul : il désactiverait l'échéance
+        double restant = options.delai_max - (horlogeMurale() - debut);
+        options.delai_max = (restant > 1e-9) ? restant : 1e-9;
     }
-
-    free(parent); free(visite); libererQueue(q);
-    return true; // Progression réelle
+    return algoMarchePiedOptions(p, &options);
 }
 
-// 4. L'algorithme Principal SILENCIEUX
-void algoMarchePiedSilencieux(ProblemeTransport* p) {
-    int n = p->n, m = p->m;
-    int** base = (int**)malloc(n * sizeof(int*));
-    double** couts_marginaux = (double**)malloc(n * sizeof(double*));
-    for(int i=0; i<n; i++) {
-        base[i] = (int*)calloc(m, sizeof(int));
-        couts_marginaux[i] = (double*)calloc(m, sizeof(double));
-    }
-    double* E_s = (double*)malloc(n * sizeof(double));
-    double* E_t = (double*)malloc(m * sizeof(double));
-
-    for(int i=0; i<n; i++)
-        for(int j=0; j<m; j++)
-            if (p->B[i][j] > 0) base[i][j] = 1;
-
-    int iter = 0;
-    int stalling = 0;
-    bool optimal = false;
-
-    // Limite de sécurité (5000 itérations)
-    while (!optimal && iter < 5000) {
-        iter++;
-
-        testerEtResoudreDegenerescenceSilencieux(p, base);
-        calculerPotentiels(p, base, E_s, E_t); // Celui-ci n'affiche rien de base, c'est bon
-
-        int i_in, j_in;
-        // Celui-ci n'affiche rien si on ne lui demande pas d'afficher la table
-        bool possible = calculerCoutsMarginaux(p, base, E_s, E_t, &i_in, &j_in, couts_marginaux);
-
-        if (!possible) {
-            optimal = true;
-        } else {
-            // Appel de la version silencieuse qui retourne false si on piétine (Theta=0)
-            bool progression = trouverEtResoudreCycleSilencieux(p, base, i_in, j_in);
-
-            if (!progression) stalling++;
-            else stalling = 0;
-
-            // Sécurité anti-boucle infinie sur les 0
-            if (stalling > 50) {
-                optimal = true; // On force l'arrêt
-            }
-        }
-    }
+SolutionCreuse* algoMarchePied(ProblemeTransport* p) {
+    TraceMarchePied console = { TRACE_DETAILLEE, 1, TRACE_CONSOLE, stdout };
+    OptionsMarchePied o;
+    optionsMarchePiedParDefaut(&o);
+    o.trace = &console;
+    return algoMarchePiedOptions(p, &o);
+}
 
-    for(int i=0; i<n; i++) { free(base[i]); free(couts_marginaux[i]); }
-    free(base); free(couts_marginaux); free(E_s); free(E_t);
+SolutionCreuse* algoMarchePiedSilencieux(ProblemeTransport* p) {
+    OptionsMarchePied o;
+    optionsMarchePiedParDefaut(&o);
+    return algoMarchePiedOptions(p, &o);
 }
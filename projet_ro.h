@@ -13,11 +13,55 @@
 #include <string.h>
 #include <float.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include <limits.h>
+#include <stdatomic.h>
 
 // ==========================================================
 // 1. STRUCTURES DE DONNEES
 // ==========================================================
 
+/**
+ * @brief Capacités maximales des cases plafonnées, stockées par ligne (format CSR).
+ * Seules les cases plafonnées sont stockées : les autres sont illimitées.
+ */
+typedef struct {
+    int nb;          // Nombre de cases plafonnées
+    int* debut;      // Taille n+1 : les cases de la ligne i occupent [debut[i], debut[i+1])
+    int* colonne;    // Taille nb : colonnes, croissantes dans chaque ligne
+    int* capacite;   // Taille nb : capacité U[i][j] de la case
+} CapacitesCreuses;
+
+/**
+ * @brief Ordres des coûts par ligne, par colonne et (optionnellement) de toutes les cases, calculés une
+ * fois pour une matrice A donnée. Indices compacts : 16 bits si n et m <= 65536, 32 bits sinon.
+ * Mis en cache dans le problème et partagés en lecture seule par ses vues (portefeuille, multi-produits).
+ * Lecture par ordreLigne, ordreColonne et ordreGlobal.
+ */
+typedef struct {
+    int n, m;
+    bool compact;    // true : lignes / colonnes en uint16_t, sinon uint32_t
+    void* lignes;    // n*m : colonnes de chaque ligne par coût croissant (égalités : indice croissant)
+    void* colonnes;  // m*n : lignes de chaque colonne par coût croissant (égalités : indice croissant)
+    uint32_t* global; // n*m : cases i*m+j par coût croissant (égalités : indice croissant), NULL si non calculé
+} OrdresCouts;
+
+/**
+ * @brief k-ième colonne de la ligne i par coût croissant.
+ */
+static inline int ordreLigne(const OrdresCouts* o, int i, int k) {
+    long pos = (long)i * o->m + k;
+    return o->compact ? ((const uint16_t*)o->lignes)[pos] : (int)((const uint32_t*)o->lignes)[pos];
+}
+
+/**
+ * @brief k-ième ligne de la colonne j par coût croissant.
+ */
+static inline int ordreColonne(const OrdresCouts* o, int j, int k) {
+    long pos = (long)j * o->n + k;
+    return o->compact ? ((const uint16_t*)o->colonnes)[pos] : (int)((const uint32_t*)o->colonnes)[pos];
+}
+
 /**
  * @brief Structure représentant une instance du problème de transport.
  */
@@ -26,11 +70,272 @@ typedef struct {
     int m;       // Nombre de clients (colonnes)
 
     double** A;  // Matrice des coûts unitaires (taille n x m)
+    double* At;  // Miroir colonne de A : At[j*n + i] = A[i][j] (NULL : absent, voir actualiserCouts)
     int* P;      // Vecteur des provisions/offres (taille n)
     int* C;      // Vecteur des commandes/demandes (taille m)
     int** B;     // Matrice de la solution (quantités transportées) (taille n x m)
+    CapacitesCreuses* U; // Capacités par case (NULL : problème non capacité)
+    OrdresCouts* ordres;  // Cache des ordres triés de A (NULL : pas encore calculé, voir ordresCouts)
+    bool ordres_possedes; // true si le cache appartient au problème (false : partagé avec le problème source)
 } ProblemeTransport;
 
+/**
+ * @brief Coûts de la colonne j, contigus (miroir colonne), ou NULL si le miroir est absent.
+ * Les parcours en colonne lisent colonne[i] au lieu de A[i][j] (une ligne de cache par case).
+ */
+static inline const double* colonneCouts(const ProblemeTransport* p, int j) {
+    return p->At ? p->At + (long)j * p->n : NULL;
+}
+
+/**
+ * @brief Case de base d'une solution creuse.
+ * Une solution de base admissible compte au plus n+m-1 cases, on ne stocke que celles-ci.
+ */
+typedef struct {
+    int i;          // Indice du fournisseur (ligne)
+    int j;          // Indice du client (colonne)
+    int quantite;   // Quantité transportée B[i][j] (0 pour une variable de base dégénérée)
+    double cout;    // Coût unitaire A[i][j]
+} CaseBase;
+
+/**
+ * @brief Représentation creuse d'une solution : liste des cases de base.
+ * Taille O(n+m) au lieu de la matrice dense B en O(n*m).
+ */
+typedef struct {
+    int n;             // Nombre de fournisseurs du problème d'origine
+    int m;             // Nombre de clients du problème d'origine
+    int nb_cases;      // Nombre de cases stockées
+    int capacite;      // Taille allouée du tableau cases
+    CaseBase* cases;   // Tableau des cases de base (ordre lexicographique (i,j))
+    double cout_total; // Coût total Z de la solution
+    double* E_s;       // Potentiels des fournisseurs à l'optimum (n), NULL si absents
+    double* E_t;       // Potentiels des clients à l'optimum (m), NULL si absents
+} SolutionCreuse;
+
+/**
+ * @brief Diagnostic de la vérification d'un certificat d'optimalité.
+ */
+typedef struct {
+    bool admissible_primal;  // Indices valides, quantités >= 0, offres et demandes respectées
+    bool admissible_dual;    // Tous les coûts marginaux A[i][j] - (E_s[i] - E_t[j]) >= -tolérance
+    double pire_cout_marginal; // Plus petit coût marginal rencontré
+    double cout_primal;      // Somme A[i][j] * quantité (recalculée depuis A)
+    double cout_dual;        // Somme P[i] * E_s[i] - Somme C[j] * E_t[j]
+    double ecart_dualite;    // |cout_primal - cout_dual|
+} RapportCertificat;
+
+/**
+ * @brief Méthodes de construction de la solution initiale.
+ */
+typedef enum {
+    METHODE_NORD_OUEST,   // Coin Nord-Ouest (ignore les coûts)
+    METHODE_BALAS_HAMMER, // Balas-Hammer (pénalités de Vogel)
+    METHODE_RUSSELL,      // Approximation de Russell
+    METHODE_MOINDRE_COUT, // Moindre coût (cases triées par coût croissant)
+    NB_METHODES_INITIALES
+} MethodeInitiale;
+
+/**
+ * @brief Couple (coût, indice) utilisé pour les tris de cases, de lignes ou de colonnes.
+ */
+typedef struct {
+    double cout;
+    uint32_t indice; // Ligne, colonne, ou case i*m+j (au-delà de INT_MAX pour les grandes grilles)
+} CoupleCout;
+
+/**
+ * @brief Niveaux de trace du Marche-Pied (cumulatifs).
+ */
+typedef enum {
+    TRACE_AUCUNE = 0,     // Aucune sortie
+    TRACE_RESUME = 1,     // Début et fin de résolution uniquement
+    TRACE_ITERATIONS = 2, // Un enregistrement par pivot (case entrante, gain, theta)
+    TRACE_DETAILLEE = 3   // Tables complètes (console) ou potentiels + base (JSONL)
+} NiveauTrace;
+
+/**
+ * @brief Formats de sortie de la trace.
+ */
+typedef enum {
+    TRACE_CONSOLE, // Affichage lisible sur la sortie standard (tables du sujet au niveau détaillé)
+    TRACE_JSONL,   // Un objet JSON par ligne dans le flux
+    TRACE_BINAIRE  // Enregistrements binaires de taille fixe dans le flux
+} FormatTrace;
+
+/**
+ * @brief Destination et filtrage de la trace du Marche-Pied.
+ */
+typedef struct {
+    NiveauTrace niveau;  // Niveau maximal des événements émis
+    int echantillonnage; // Une itération tracée toutes les k itérations (1 = toutes)
+    FormatTrace format;  // Format de sortie
+    FILE* flux;          // Flux de sortie (ignoré en mode console)
+} TraceMarchePied;
+
+/**
+ * @brief Pool de threads persistant (structure opaque, voir parallele.c).
+ */
+typedef struct PoolThreads PoolThreads;
+
+/**
+ * @brief Tâche exécutée par le pool : indice de la tâche parmi nb_taches.
+ */
+typedef void (*TacheParallele)(void* contexte, int indice, int nb_taches);
+
+/**
+ * @brief Compteurs matériels du thread appelant, cumulés par phase (structure opaque, voir compteurs.c).
+ */
+typedef struct CompteursMateriels CompteursMateriels;
+
+/**
+ * @brief Raison de l'arrêt du Marche-Pied.
+ */
+typedef enum {
+    ARRET_OPTIMAL,     // Aucun coût marginal négatif
+    ARRET_ITERATIONS,  // Budget d'itérations épuisé
+    ARRET_STAGNATION,  // Trop de pas dégénérés consécutifs
+    ARRET_DELAI,       // Échéance (horloge murale) atteinte
+    ARRET_ANNULATION,  // Annulation demandée par un autre thread
+    ARRET_IRREALISABLE // Capacités insuffisantes : offre non entièrement acheminée
+} CauseArret;
+
+/**
+ * @brief Statistiques renvoyées par le Marche-Pied.
+ */
+typedef struct {
+    int pivots;         // Nombre de pivots (changements de base) effectués
+    int pas_degeneres;  // Pivots avec theta = 0
+    bool optimal;       // true si l'optimalité est prouvée (aucun coût marginal négatif)
+    CauseArret cause;   // Raison de l'arrêt
+    double cout_initial; // Coût de la solution reçue en entrée
+    double cout_total;  // Coût de la solution renvoyée
+    double ecart_max;   // Borne supérieure de (coût - optimum), 0 si optimal, DBL_MAX si irréalisable
+} ResultatMarchePied;
+
+/**
+ * @brief Options de l'algorithme du Marche-Pied.
+ * Initialiser avec optionsMarchePiedParDefaut puis modifier les champs utiles.
+ */
+typedef struct {
+    int max_iterations;            // Nombre maximal de pivots
+    int max_stagnation;            // Nombre maximal de pas dégénérés (theta = 0) consécutifs
+    const TraceMarchePied* trace;  // Trace structurée (NULL = silencieux)
+    PoolThreads* pool;             // Calcul parallèle des coûts marginaux (NULL = séquentiel)
+    ResultatMarchePied* resultat;  // Statistiques en sortie (NULL = non demandées)
+    const atomic_bool* annulation; // Arrêt coopératif demandé par un autre thread (NULL = jamais)
+    double delai_max;              // Temps maximal en secondes, horloge murale (<= 0 : aucun)
+    CompteursMateriels* compteurs; // Potentiels, coûts marginaux et cycle mesurés par phase (NULL = non)
+} OptionsMarchePied;
+
+/**
+ * @brief Résultat d'une résolution en portefeuille (plusieurs pipelines en concurrence).
+ */
+typedef struct {
+    MethodeInitiale gagnante;     // Méthode initiale du pipeline retenu
+    bool optimal;                 // true si le pipeline retenu a prouvé l'optimalité
+    int pivots;                   // Pivots du pipeline retenu
+    double cout_total;            // Coût de la solution retenue
+    double duree;                 // Temps écoulé (s, horloge murale)
+} ResultatPortfolio;
+
+/**
+ * @brief Analyse de sensibilité d'une base optimale (voir sensibilite.c).
+ * L'arbre de la base relie les noeuds 0..n-1 (fournisseurs) et n..n+m-1 (clients), racine F0.
+ */
+typedef struct {
+    int n, m;
+    double* cout_min;  // n*m (ligne par ligne) : plus petit A[i][j] conservant la base (-DBL_MAX : illimité)
+    double* cout_max;  // n*m : plus grand A[i][j] conservant la base (DBL_MAX : illimité)
+    int* parent;       // n+m : parent du noeud dans l'arbre de la base (-1 pour la racine)
+    int* profondeur;   // n+m : profondeur du noeud
+    int* flux_parent;  // n+m : quantité de la case reliant le noeud à son parent
+    double* E_s;       // Potentiels des fournisseurs (copie)
+    double* E_t;       // Potentiels des clients (copie)
+} AnalyseSensibilite;
+
+/**
+ * @brief Second membre d'un produit en mode multi-produits : A est partagée, P et C sont propres au produit.
+ */
+typedef struct {
+    int* P;                    // Offres (taille n, fournies par l'appelant)
+    int* C;                    // Demandes (taille m, fournies par l'appelant)
+    SolutionCreuse* solution;  // Base finale (sortie, à libérer avec libererSolutionCreuse)
+    ResultatMarchePied stats;  // Statistiques du Marche-Pied (sortie)
+    bool demarrage_chaud;      // true si la base du produit précédent a servi de départ (sortie)
+} ProduitTransport;
+
+/**
+ * @brief Bilan d'une résolution par décomposition en blocs indépendants (voir resoudreDecompose).
+ */
+typedef struct {
+    int nb_blocs;          // Composantes du graphe des liaisons ouvertes (1 : pas de décomposition)
+    bool decompose;        // true si les blocs ont été résolus séparément
+    int plus_grand_n;      // Dimensions du plus grand bloc
+    int plus_grand_m;
+    int pivots_blocs;      // Pivots cumulés des blocs
+    double duree_blocs;    // Temps de la phase par blocs (secondes, horloge murale)
+} ResultatDecomposition;
+
+// Coût à partir duquel une liaison est considérée comme fermée par la décomposition
+#define SEUIL_COUT_INTERDIT 1e9
+
+/**
+ * @brief Problème de transbordement sur un réseau général (voir transbordement.c).
+ * Noeuds 0..nb_noeuds-1 : offre > 0 (fournisseur), < 0 (demande d'un client), 0 (transit, entrepôt).
+ * Les arcs relient n'importe quelle paire de noeuds ; stockage creux en listes d'arcs.
+ */
+typedef struct {
+    int nb_noeuds;
+    int nb_arcs;
+    int capacite_arcs;  // Taille allouée des tableaux d'arcs
+    int* offre;         // nb_noeuds : offre (> 0) ou demande (< 0) ; somme nulle
+    int* origine;       // nb_arcs : noeud de départ
+    int* destination;   // nb_arcs : noeud d'arrivée
+    double* cout;       // nb_arcs : coût unitaire
+    int* capacite;      // nb_arcs : capacité (INT_MAX : non plafonné)
+    int* flux;          // nb_arcs : quantité transportée (solution)
+    double* potentiel;  // nb_noeuds : potentiels E (E_u - E_v = coût des arcs de base), renseignés à l'optimum
+} ReseauTransbordement;
+
+/**
+ * @brief Codes de retour de l'API de bibliothèque (voir section 12).
+ */
+typedef enum {
+    RETOUR_OK = 0,           // Solution optimale disponible
+    RETOUR_ARRET_ANTICIPE,   // Budget, délai ou annulation : solution admissible non prouvée optimale
+    RETOUR_ARGUMENT_INVALIDE, // Pointeur nul, dimension ou valeur hors limites
+    RETOUR_DESEQUILIBRE,     // Somme des offres différente de la somme des demandes
+    RETOUR_IRREALISABLE,     // Capacités insuffisantes pour acheminer toute l'offre
+    RETOUR_MEMOIRE,          // Erreur d'allocation
+    RETOUR_COMMUNICATION     // Échange avec le démon interrompu ou message invalide (section 13)
+} CodeRetour;
+
+/**
+ * @brief Poignée d'un solveur de la bibliothèque (structure opaque, voir solveur.c).
+ * Possède son problème, sa dernière solution et son pool de threads ; aucun état global.
+ */
+typedef struct SolveurTransport SolveurTransport;
+
+/**
+ * @brief Cache des solutions optimales, indexé par empreinte d'instance (structure opaque, voir cache.c).
+ */
+typedef struct CacheSolutions CacheSolutions;
+
+/**
+ * @brief Options d'une résolution par la bibliothèque.
+ */
+typedef struct {
+    MethodeInitiale methode;  // Solution initiale (ignorée si la base précédente est reprise)
+    bool reprendre_base;      // Repartir de la base de la résolution précédente si elle reste admissible
+    int max_iterations;       // Budget de pivots du Marche-Pied
+    double delai_max;         // Échéance en secondes (0 : aucune)
+    int nb_threads;           // Threads des coûts marginaux (1 : séquentiel, 0 : tous les coeurs)
+    PoolThreads* pool;        // Pool externe partagé entre poignées, lots sérialisés (NULL : pool propre selon nb_threads)
+    CacheSolutions* cache;    // Cache des solutions optimales (NULL : aucun), voir section 14
+    const atomic_bool* annulation; // Arrêt demandé depuis un autre thread (NULL : aucun)
+} OptionsSolveur;
+
 /**
  * @brief Noeud pour la file (Queue) utilisée dans le parcours BFS.
  * Sert à détecter les cycles et vérifier la connexité.
@@ -50,6 +355,73 @@ typedef struct {
     int capacity;  // Capacité maximale
 } Queue;
 
+/**
+ * @brief Base du Marche-Pied en ensembles de bits, 64 cases par mot : une vue par ligne (colonnes en base)
+ * et une par colonne (lignes en base), tenues à jour ensemble. Les parcours BFS avancent mot par mot
+ * (ET-NON avec les sommets déjà vus, puis bit de poids faible) au lieu de tester un int par case.
+ */
+typedef struct {
+    int n, m;
+    int mots_lig;       // Mots par ligne : (m + 63) / 64
+    int mots_col;       // Mots par colonne : (n + 63) / 64
+    uint64_t* lignes;   // n * mots_lig : bit j de la ligne i si la case (i, j) est en base
+    uint64_t* colonnes; // m * mots_col : bit i de la colonne j si la case (i, j) est en base
+    // Espace des parcours, alloué avec la base : un BFS n'alloue rien et ne peut pas échouer
+    Queue* file;        // n + m noeuds
+    uint64_t* vus_lig;  // mots_col mots : lignes déjà atteintes
+    uint64_t* vus_col;  // mots_lig mots : colonnes déjà atteintes
+    int* parent;        // n + m : parent de chaque sommet dans le dernier parcours
+} BaseBinaire;
+
+/**
+ * @brief true si la case (i, j) est en base.
+ */
+static inline bool estDeBase(const BaseBinaire* b, int i, int j) {
+    return (b->lignes[(long)i * b->mots_lig + (j >> 6)] >> (j & 63)) & 1u;
+}
+
+/**
+ * @brief Met la case (i, j) en base (vues ligne et colonne).
+ */
+static inline void ajouterDeBase(BaseBinaire* b, int i, int j) {
+    b->lignes[(long)i * b->mots_lig + (j >> 6)] |= (uint64_t)1 << (j & 63);
+    b->colonnes[(long)j * b->mots_col + (i >> 6)] |= (uint64_t)1 << (i & 63);
+}
+
+/**
+ * @brief Retire la case (i, j) de la base (vues ligne et colonne).
+ */
+static inline void retirerDeBase(BaseBinaire* b, int i, int j) {
+    b->lignes[(long)i * b->mots_lig + (j >> 6)] &= ~((uint64_t)1 << (j & 63));
+    b->colonnes[(long)j * b->mots_col + (i >> 6)] &= ~((uint64_t)1 << (i & 63));
+}
+
+/**
+ * @brief Indice du bit de poids faible d'un mot non nul.
+ */
+static inline int bitPoidsFaible(uint64_t x) {
+#if defined(__GNUC__)
+    return __builtin_ctzll(x);
+#else
+    int k = 0;
+    while (!(x & 1u)) { x >>= 1; k++; }
+    return k;
+#endif
+}
+
+/**
+ * @brief Nombre de bits à 1 d'un mot.
+ */
+static inline int compterBits(uint64_t x) {
+#if defined(__GNUC__)
+    return __builtin_popcountll(x);
+#else
+    int k = 0;
+    for (; x; x &= x - 1) k++;
+    return k;
+#endif
+}
+
 
 // ==========================================================
 // 2. GESTION DE LA MÉMOIRE ET INITIALISATION
@@ -60,7 +432,7 @@ typedef struct {
  * Initialise la matrice de solution B à 0.
  * @param n Nombre de fournisseurs.
  * @param m Nombre de clients.
- * @return Pointeur vers la structure allouée.
+ * @return Pointeur vers la structure allouée, NULL en cas d'erreur d'allocation.
  */
 ProblemeTransport* creerProbleme(int n, int m);
 
@@ -72,12 +444,30 @@ void libererProbleme(ProblemeTransport* p);
 
 /**
  * @brief Lit un fichier de données et construit la structure ProblemeTransport associée.
- * Le fichier doit respecter le format défini par le sujet.
+ * Le fichier doit respecter le format défini par le sujet. Il peut se terminer par une section
+ * optionnelle de capacités : un entier K puis K triplets "i j U[i][j]".
  * @param nomFichier Chemin vers le fichier .txt.
- * @return Pointeur vers le problème chargé, ou NULL en cas d'erreur.
+ * @return Pointeur vers le problème chargé, ou NULL en cas d'erreur (voir chargerDonnees).
  */
 ProblemeTransport* lireDonnees(const char* nomFichier);
 
+/**
+ * @brief Variante de lireDonnees qui précise la cause d'un échec. Chaque valeur doit être lue :
+ * un fichier tronqué, un coût non fini, une offre ou une demande négative sont rejetés.
+ * @param nomFichier Chemin vers le fichier .txt.
+ * @param sortie Reçoit le problème chargé (NULL en cas d'échec).
+ * @return RETOUR_OK, RETOUR_ARGUMENT_INVALIDE (fichier absent ou mal formé), RETOUR_DESEQUILIBRE
+ * (somme des offres différente de celle des demandes) ou RETOUR_MEMOIRE.
+ */
+CodeRetour chargerDonnees(const char* nomFichier, ProblemeTransport** sortie);
+
+/**
+ * @brief À appeler après toute écriture dans A : reconstruit le miroir colonne At et vide le cache
+ * des ordres triés. lireDonnees l'appelle au chargement.
+ * @return false si le miroir n'a pas pu être alloué (les parcours en colonne lisent alors A).
+ */
+bool actualiserCouts(ProblemeTransport* p);
+
 /**
  * @brief Réinitialise la matrice de solution B à 0.
  * Utile avant d'exécuter un nouvel algorithme sur les mêmes données.
@@ -85,6 +475,45 @@ ProblemeTransport* lireDonnees(const char* nomFichier);
  */
 void reinitialiserSolution(ProblemeTransport* p);
 
+/**
+ * @brief Définit les capacités des cases plafonnées (remplace les capacités existantes).
+ * @param p Le problème.
+ * @param nb Nombre de cases plafonnées (0 : supprime les capacités).
+ * @param lignes Indices des fournisseurs.
+ * @param colonnes Indices des clients.
+ * @param capacites Capacités (>= 0). En cas de doublon, la plus petite est retenue.
+ * @return false si un indice est hors limites, une capacité négative ou en cas d'erreur d'allocation.
+ */
+bool definirCapacites(ProblemeTransport* p, int nb, const int* lignes, const int* colonnes, const int* capacites);
+
+/**
+ * @brief Capacité de la case (i, j) : recherche dichotomique dans la ligne i, O(log k).
+ * @return La capacité, INT_MAX si la case n'est pas plafonnée.
+ */
+int capaciteCase(const ProblemeTransport* p, int i, int j);
+
+/**
+ * @brief Vérifie que B respecte offres, demandes, positivité et capacités.
+ * @param p Le problème.
+ * @return true si la solution est admissible.
+ */
+bool solutionAdmissible(const ProblemeTransport* p);
+
+/**
+ * @brief Crée une vue d'un problème qui partage A, P, C et U avec la source mais possède sa propre matrice B.
+ * Permet de résoudre la même instance dans plusieurs threads sans recopier les coûts.
+ * La source doit rester valide et non modifiée tant que la vue existe.
+ * @param source Le problème d'origine.
+ * @return La vue (B à 0), NULL en cas d'erreur d'allocation.
+ */
+ProblemeTransport* creerProblemePartage(const ProblemeTransport* source);
+
+/**
+ * @brief Libère une vue créée par creerProblemePartage (seule sa matrice B est libérée).
+ * @param p La vue (peut être NULL).
+ */
+void libererProblemePartage(ProblemeTransport* p);
+
 
 // ==========================================================
 // 3. AFFICHAGE ET ANALYSE
@@ -123,44 +552,151 @@ void afficherTableauPotentiels(ProblemeTransport* p, double* E_s, double* E_t);
  * Affiche les opportunités d'amélioration pour les cases hors-base.
  * @param p Le problème.
  * @param couts_marginaux Matrice des coûts marginaux.
- * @param base Matrice binaire identifiant les variables de base.
+ * @param base Cases de la base (ensembles de bits).
  */
-void afficherTableauMarginaux(ProblemeTransport* p, double** couts_marginaux, int** base);
+void afficherTableauMarginaux(ProblemeTransport* p, double** couts_marginaux, BaseBinaire* base);
 
 
 // ==========================================================
 // 4. ALGORITHMES DE SOLUTION INITIALE
 // ==========================================================
 
+/**
+ * Problème capacité (p->U non NULL) : les méthodes initiales n'affectent jamais plus que U[i][j]
+ * à une case et ignorent les cases pleines ; l'offre et la demande restantes sont ensuite acheminées
+ * par chemins augmentants (cases non pleines dans le sens direct, cases non vides à rebours).
+ * Si aucun chemin n'existe, le problème est irréalisable et B reste incomplète (voir solutionAdmissible).
+ */
+
 /**
  * @brief Génère une solution initiale via la méthode du Coin Nord-Ouest.
  * Algorithme simple mais ne garantissant pas une solution proche de l'optimal.
  * Affiche toutes les étapes de construction.
  * @param p Le problème à résoudre.
+ * @return Coût total de la solution construite (cumulé à chaque affectation, sans rebalayer B).
  */
-void algoNordOuest(ProblemeTransport* p);
+double algoNordOuest(ProblemeTransport* p);
 
 /**
  * @brief Version silencieuse de Nord-Ouest (sans affichage détaillé).
  * Utilisée dans les pipelines (options 3 et 4) pour éviter la redondance.
  * @param p Le problème à résoudre.
+ * @return Coût total de la solution construite (cumulé à chaque affectation, sans rebalayer B).
+ */
+double algoNordOuestSilencieux(ProblemeTransport* p);
+
+/**
+ * Les méthodes initiales lisent les coûts dans l'ordre trié du cache ordresCouts(p) : le tri est fait
+ * une seule fois par matrice A, puis réutilisé par toutes les résolutions et méthodes suivantes.
+ */
+
+/**
+ * @brief Calcule les ordres croissants des coûts de chaque ligne et de chaque colonne (O(nm log nm)).
+ * @param p Le problème (seule A est lue).
+ * @param avec_global true pour trier aussi l'ensemble des n*m cases (moindre coût).
+ * @return Les ordres (à libérer avec libererOrdresCouts), NULL en cas d'erreur d'allocation.
+ */
+OrdresCouts* calculerOrdresCouts(const ProblemeTransport* p, bool avec_global);
+
+/**
+ * @brief Libère des ordres de coûts.
+ * @param o Les ordres (peut être NULL).
+ */
+void libererOrdresCouts(OrdresCouts* o);
+
+/**
+ * @brief Ordres des coûts du problème, calculés au premier appel puis conservés dans p->ordres.
+ * Un cache possédé sans ordre global est complété si avec_global ; un cache partagé incomplet est
+ * remplacé par un cache propre au problème.
+ * @return Les ordres (appartenant au problème), NULL en cas d'erreur d'allocation.
  */
-void algoNordOuestSilencieux(ProblemeTransport* p);
+const OrdresCouts* ordresCouts(ProblemeTransport* p, bool avec_global);
+
+/**
+ * @brief Vide le cache des ordres : à appeler après toute modification de la matrice A.
+ */
+void invaliderOrdresCouts(ProblemeTransport* p);
 
 /**
  * @brief Génère une solution initiale via la méthode de Balas-Hammer (approximation de Vogel).
  * Utilise les pénalités pour choisir les cases prioritaires.
+ * Les deux plus petits coûts actifs d'une ligne ou d'une colonne sont lus derrière deux curseurs sur
+ * l'ordre trié, qui sautent les colonnes / lignes saturées (avance amortie O(1) au lieu d'un balayage).
  * Affiche toutes les itérations avec pénalités et choix de cases.
  * @param p Le problème à résoudre.
+ * @return Coût total de la solution construite (cumulé à chaque affectation, sans rebalayer B).
  */
-void algoBalasHammer(ProblemeTransport* p);
+double algoBalasHammer(ProblemeTransport* p);
 
 /**
  * @brief Version silencieuse de Balas-Hammer (sans affichage détaillé).
  * Utilisée dans les pipelines (options 3 et 4) pour éviter la redondance.
  * @param p Le problème à résoudre.
+ * @return Coût total de la solution construite (cumulé à chaque affectation, sans rebalayer B).
+ */
+double algoBalasHammerSilencieux(ProblemeTransport* p);
+
+/**
+ * @brief Génère une solution initiale par la méthode du moindre coût.
+ * Les n*m cases sont balayées dans l'ordre global du cache (trié une fois par matrice A) :
+ * chaque case dont la ligne et la colonne sont actives reçoit min(offre, demande) restantes.
+ * Affiche chaque affectation.
+ * @param p Le problème à résoudre.
+ * @return Coût total de la solution construite (cumulé à chaque affectation, sans rebalayer B).
+ */
+double algoMoindreCout(ProblemeTransport* p);
+
+/**
+ * @brief Version silencieuse du moindre coût.
+ * @param p Le problème à résoudre.
+ * @return Coût total de la solution construite (cumulé à chaque affectation, sans rebalayer B).
+ */
+double algoMoindreCoutSilencieux(ProblemeTransport* p);
+
+/**
+ * @brief Génère une solution initiale par l'approximation de Russell.
+ * À chaque étape : u_i = coût max de la ligne i, v_j = coût max de la colonne j (cases actives),
+ * la case de plus petit A[i][j] - u_i - v_j reçoit min(offre, demande) restantes.
+ * u et v sont maintenus par curseurs parcourant à rebours les ordres croissants du cache.
+ * Affiche chaque itération (u, v, Delta, case choisie).
+ * @param p Le problème à résoudre.
+ * @return Coût total de la solution construite (cumulé à chaque affectation, sans rebalayer B).
+ */
+double algoRussell(ProblemeTransport* p);
+
+/**
+ * @brief Version silencieuse de Russell.
+ * @param p Le problème à résoudre.
+ * @return Coût total de la solution construite (cumulé à chaque affectation, sans rebalayer B).
+ */
+double algoRussellSilencieux(ProblemeTransport* p);
+
+/**
+ * @brief Applique la méthode initiale choisie (version affichée ou silencieuse).
+ * @param p Le problème à résoudre.
+ * @param methode Méthode à appliquer.
+ * @param affichage true pour la version affichée.
+ * @return Coût total de la solution construite.
+ */
+double appliquerMethodeInitiale(ProblemeTransport* p, MethodeInitiale methode, bool affichage);
+
+/**
+ * @brief Nom lisible d'une méthode initiale ("Nord-Ouest", "Balas-Hammer", ...).
+ */
+const char* nomMethodeInitiale(MethodeInitiale methode);
+
+/**
+ * @brief Abréviation d'une méthode initiale ("NO", "BH", "RU", "MC").
+ */
+const char* abreviationMethodeInitiale(MethodeInitiale methode);
+
+/**
+ * @brief Lit une méthode initiale depuis son code texte ("no", "bh", "ru"/"russell", "mc").
+ * @param texte Code de la méthode.
+ * @param methode Méthode lue (sortie).
+ * @return false si le code est inconnu.
  */
-void algoBalasHammerSilencieux(ProblemeTransport* p);
+bool lireMethodeInitiale(const char* texte, MethodeInitiale* methode);
 
 
 // ==========================================================
@@ -171,9 +707,55 @@ void algoBalasHammerSilencieux(ProblemeTransport* p);
  * @brief Algorithme principal du Marche-Pied (Stepping-Stone).
  * Itère pour améliorer la solution initiale jusqu'à l'optimalité.
  * Affiche toutes les itérations avec détection de cycles, connexité, et coûts.
+ * La solution de chaque itération est affichée sous forme creuse (cases de base uniquement).
  * @param p Le problème contenant une solution initiale admissible.
+ * @return La base finale sous forme creuse (à libérer avec libererSolutionCreuse), NULL si erreur d'allocation.
  */
-void algoMarchePied(ProblemeTransport* p);
+SolutionCreuse* algoMarchePied(ProblemeTransport* p);
+
+/**
+ * @brief Remplit les options du Marche-Pied avec les valeurs par défaut.
+ * 5000 itérations, 50 pas dégénérés consécutifs au maximum, aucune trace, calcul séquentiel.
+ * @param o Options à initialiser.
+ */
+void optionsMarchePiedParDefaut(OptionsMarchePied* o);
+
+/**
+ * @brief Implémentation unique du Marche-Pied, paramétrée par ses options.
+ * algoMarchePied (trace console détaillée) et algoMarchePiedSilencieux (sans trace) en sont des cas particuliers.
+ * Avec une trace échantillonnée (1 itération sur k), les itérations non tracées ne coûtent aucune entrée/sortie.
+ * @param p Le problème contenant une solution initiale admissible.
+ * @param o Options (limites d'itérations et trace).
+ * Si l'optimalité est prouvée, la solution porte les potentiels finaux (certificat dual).
+ * @return La base finale sous forme creuse (à libérer avec libererSolutionCreuse), NULL si erreur d'allocation.
+ */
+SolutionCreuse* algoMarchePiedOptions(ProblemeTransport* p, const OptionsMarchePied* o);
+
+/**
+ * @brief Résolution « anytime » : méthode initiale puis Marche-Pied sous budget.
+ * L'échéance o->delai_max couvre la méthode initiale et le Marche-Pied ; le budget d'itérations est
+ * o->max_iterations et o->annulation permet l'arrêt depuis un autre thread. La méthode initiale
+ * s'exécute toujours jusqu'au bout : une solution admissible est renvoyée même si le délai est déjà écoulé.
+ * @param p Le problème (B est écrasée).
+ * @param methode Méthode initiale.
+ * @param o Options du Marche-Pied (NULL : valeurs par défaut).
+ * @param resultat Statistiques, coût et borne d'écart à l'optimum (peut être NULL).
+ * @return La meilleure base obtenue sous forme creuse (à libérer), NULL si erreur d'allocation.
+ */
+SolutionCreuse* resoudreAnytime(ProblemeTransport* p, MethodeInitiale methode,
+                                const OptionsMarchePied* o, ResultatMarchePied* resultat);
+
+/**
+ * @brief Borne supérieure de l'écart entre le coût de la solution courante et l'optimum.
+ * Les potentiels sont rendus duaux-admissibles en ajoutant à chaque E_s[i] le plus petit coût marginal
+ * (négatif) de sa ligne, ce qui donne un minorant Z_min = Somme P[i]*E_s'[i] - Somme C[j]*E_t[j] ;
+ * idem par colonnes, le meilleur des deux minorants est retenu. Coût O(n*m).
+ * @param p Le problème (solution courante dans B).
+ * @param E_s Potentiels des fournisseurs (DBL_MAX : non atteint, traité comme 0).
+ * @param E_t Potentiels des clients.
+ * @return Coût courant - minorant (>= 0).
+ */
+double borneEcartOptimalite(ProblemeTransport* p, double* E_s, double* E_t);
 
 /**
  * @brief Vérifie si la solution est dégénérée et résout les problèmes de cycles/connexité.
@@ -181,37 +763,39 @@ void algoMarchePied(ProblemeTransport* p);
  * - Détection et résolution répétée de TOUS les cycles
  * - Ajout d'arêtes par coûts croissants pour garantir la connexité
  * @param p Le problème.
- * @param base Matrice binaire identifiant les variables de base.
+ * @param base Cases de la base (ensembles de bits).
  * @return true si la dégénérescence a été traitée, false sinon.
  */
-bool testerEtResoudreDegenerescence(ProblemeTransport* p, int** base);
+bool testerEtResoudreDegenerescence(ProblemeTransport* p, BaseBinaire* base);
 
 /**
  * @brief Teste la connexité du graphe et affiche les composantes connexes.
  * Utilise un parcours BFS pour identifier les composantes.
  * @param p Le problème.
- * @param base Matrice binaire identifiant les variables de base.
+ * @param base Cases de la base (ensembles de bits).
  * @return true si connexe, false sinon.
  */
-bool testerConnexite(ProblemeTransport* p, int** base);
+bool testerConnexite(ProblemeTransport* p, BaseBinaire* base);
 
 /**
  * @brief Calcule les potentiels des lignes (E_s) et des colonnes (E_t) sur la base actuelle.
  * Système d'équations : E_s[i] - E_t[j] = A[i][j] pour toute case (i,j) de la base.
  * Utilise un parcours BFS en fixant E_s[0] = 0 comme référence.
  * @param p Le problème.
- * @param base Matrice binaire identifiant les variables de base.
+ * @param base Cases de la base (ensembles de bits).
  * @param E_s Tableau des potentiels des fournisseurs (sortie).
  * @param E_t Tableau des potentiels des clients (sortie).
  */
-void calculerPotentiels(ProblemeTransport* p, int** base, double* E_s, double* E_t);
+void calculerPotentiels(ProblemeTransport* p, BaseBinaire* base, double* E_s, double* E_t);
 
 /**
  * @brief Calcule les coûts marginaux pour les variables hors-base.
  * Détermine si une amélioration est possible (Critère de Dantzig).
+ * Problème capacité : une case hors base non vide est à sa capacité ; elle est candidate si son coût
+ * marginal est positif (on diminue alors sa quantité).
  * Applique la règle de Bland pour la variable entrante (parcours lexicographique).
  * @param p Le problème.
- * @param base Matrice binaire identifiant les variables de base.
+ * @param base Cases de la base (ensembles de bits).
  * @param E_s Tableau des potentiels des fournisseurs.
  * @param E_t Tableau des potentiels des clients.
  * @param i_ajout Pointeur pour stocker l'indice ligne de la variable entrante.
@@ -219,20 +803,25 @@ void calculerPotentiels(ProblemeTransport* p, int** base, double* E_s, double* E
  * @param couts_marginaux Matrice des coûts marginaux (sortie).
  * @return true si une amélioration est possible (coût marginal négatif trouvé), false si optimal.
  */
-bool calculerCoutsMarginaux(ProblemeTransport* p, int** base, double* E_s, double* E_t,
+bool calculerCoutsMarginaux(ProblemeTransport* p, BaseBinaire* base, double* E_s, double* E_t,
                             int* i_ajout, int* j_ajout, double** couts_marginaux);
 
 /**
  * @brief Identifie le cycle créé par l'ajout de la variable (i_ajout, j_ajout) et met à jour la solution.
  * Affiche le cycle détecté, les conditions de maximisation (theta), et l'arête sortante.
- * Implémente l'AMÉLIORATION 2 : Gestion du cas θ = 0 (dégénérescence cyclique).
- * Applique la règle de Bland pour la variable sortante (indice minimal).
+ * Implémente l'AMÉLIORATION 2 : un pas θ = 0 est un échange de base ordinaire (aucun transfert,
+ * la base reste un arbre couvrant), au même coût qu'un pas non dégénéré.
+ * Applique la règle de Bland pour la variable sortante (indice minimal) ; après plus de n+m pas
+ * dégénérés consécutifs, le Marche-Pied choisit aussi l'entrante par la règle de Bland.
+ * Problème capacité : theta est aussi limité par la capacité restante des cases augmentées ; si la
+ * case entrante atteint elle-même sa borne la première, elle change de borne sans entrer en base.
  * @param p Le problème.
- * @param base Matrice binaire identifiant les variables de base.
+ * @param base Cases de la base (ensembles de bits).
  * @param i_ajout Indice ligne de la variable entrante.
  * @param j_ajout Indice colonne de la variable entrante.
+ * @return false si le pas est dégénéré (theta = 0), true sinon.
  */
-void trouverEtResoudreCycle(ProblemeTransport* p, int** base, int i_ajout, int j_ajout);
+bool trouverEtResoudreCycle(ProblemeTransport* p, BaseBinaire* base, int i_ajout, int j_ajout);
 
 
 // ==========================================================
@@ -242,7 +831,7 @@ void trouverEtResoudreCycle(ProblemeTransport* p, int** base, int i_ajout, int j
 /**
  * @brief Crée une file (queue) de capacité donnée pour les parcours BFS.
  * @param capacity Capacité maximale de la file.
- * @return Pointeur vers la file créée.
+ * @return Pointeur vers la file créée, NULL en cas d'erreur d'allocation.
  */
 Queue* creerQueue(int capacity);
 
@@ -274,6 +863,32 @@ BFSNode dequeue(Queue* q);
  */
 bool isQueueEmpty(Queue* q);
 
+/**
+ * @brief Alloue une base vide (aucune case) pour un problème n x m, avec l'espace de ses parcours.
+ * @return La base, NULL si erreur d'allocation.
+ */
+BaseBinaire* creerBaseBinaire(int n, int m);
+
+/**
+ * @brief Libère une base allouée par creerBaseBinaire.
+ */
+void libererBaseBinaire(BaseBinaire* b);
+
+/**
+ * @brief Nombre de cases en base (comptage de bits sur la vue par ligne).
+ */
+int compterCasesBase(const BaseBinaire* b);
+
+/**
+ * @brief Temps d'horloge murale en secondes (origine arbitraire), pour les échéances et les mesures.
+ */
+double horlogeMurale(void);
+
+/**
+ * @brief Libellé d'une cause d'arrêt du Marche-Pied ("optimal", "delai", ...).
+ */
+const char* nomCauseArret(CauseArret cause);
+
 // ==========================================================
 // 7. OUTILS Pour l'étude de la complexité
 // ==========================================================
@@ -281,21 +896,853 @@ bool isQueueEmpty(Queue* q);
 #ifndef ETUDE_COMPLEXITE_H
 #define ETUDE_COMPLEXITE_H
 
+/**
+ * @brief Paramètres de l'étude de complexité.
+ */
+typedef struct {
+    int nb_threads_pricing; // Threads pour les coûts marginaux du Marche-Pied (1 = séquentiel, 0 = tous les coeurs)
+    bool interactif;        // Attendre Entrée en fin d'étude (retour au menu)
+    uint64_t graine;        // Graine du générateur local des instances (0 : horloge)
+    bool compteurs_materiels; // Compteurs matériels par phase ajoutés aux raw_n*.dat (voir section 16)
+    int taille_max;         // Plus grande taille étudiée (120 par défaut ; jusqu'à 5000)
+    int nb_essais;          // Instances aléatoires par taille
+    long long plafond_memoire; // Octets de tas par résolution au-delà desquels une méthode est écartée (0 : aucun)
+} ConfigEtude;
+
+/**
+ * @brief Remplit la configuration de l'étude avec les valeurs par défaut (séquentiel, interactif, sans compteurs,
+ * tailles 10 à 120, 20 essais, sans plafond mémoire).
+ * @param config Configuration à initialiser.
+ */
+void configEtudeParDefaut(ConfigEtude* config);
+
 /**
  * @brief Lance la batterie de tests aléatoires et génère les CSV/Python.
  */
 void lancer_etude_complete();
 
+/**
+ * @brief Lance l'étude de complexité avec une configuration donnée.
+ * @param config Paramètres de l'étude.
+ */
+void lancer_etude_configuree(const ConfigEtude* config);
+
 #endif
 
 /**
  * @brief Versions silencieuses pour l'étude de complexité.
+ * Générées à la compilation depuis la même source que les versions affichées (projet_ro_algos.inc),
+ * avec la politique d'observation désactivée : aucun code d'affichage n'y est compilé.
+ * algoMarchePiedSilencieux renvoie la base finale sous forme creuse (à libérer par l'appelant).
+ */
+SolutionCreuse* algoMarchePiedSilencieux(ProblemeTransport* p);
+
+bool trouverEtResoudreCycleSilencieux(ProblemeTransport* p, BaseBinaire* base, int i_ajout, int j_ajout);
+
+bool testerConnexiteSilencieux(ProblemeTransport* p, BaseBinaire* base);
+bool testerEtResoudreDegenerescenceSilencieux(ProblemeTransport* p, BaseBinaire* base);
+
+// ==========================================================
+// 8. SOLUTION CREUSE ET EXPORT
+// ==========================================================
+
+/**
+ * @brief Alloue une solution creuse vide pour un problème n x m.
+ * La capacité initiale est n+m-1 (taille d'une base), agrandie si nécessaire.
+ * @param n Nombre de fournisseurs.
+ * @param m Nombre de clients.
+ * @return Pointeur vers la solution, NULL en cas d'erreur d'allocation.
  */
-void algoMarchePiedSilencieux(ProblemeTransport* p);
+SolutionCreuse* creerSolutionCreuse(int n, int m);
 
-bool trouverEtResoudreCycleSilencieux(ProblemeTransport* p, int** base, int i_ajout, int j_ajout);
+/**
+ * @brief Libère une solution creuse.
+ * @param s La solution à libérer (peut être NULL).
+ */
+void libererSolutionCreuse(SolutionCreuse* s);
+
+/**
+ * @brief Copie profonde d'une solution creuse (cases et potentiels).
+ * @return La copie (à libérer), NULL en cas d'erreur d'allocation.
+ */
+SolutionCreuse* copierSolutionCreuse(const SolutionCreuse* s);
+
+/**
+ * @brief Ajoute une case de base à la solution et met à jour le coût total.
+ * @param s La solution.
+ * @param i Indice du fournisseur.
+ * @param j Indice du client.
+ * @param quantite Quantité transportée.
+ * @param cout Coût unitaire de la case.
+ * @return true si l'ajout a réussi, false en cas d'erreur d'allocation.
+ */
+bool ajouterCaseBase(SolutionCreuse* s, int i, int j, int quantite, double cout);
 
-bool testerConnexiteSilencieux(ProblemeTransport* p, int** base);
-bool testerEtResoudreDegenerescenceSilencieux(ProblemeTransport* p, int** base);
+/**
+ * @brief Construit la solution creuse à partir de la matrice dense B (cases non nulles).
+ * Utile après un algorithme initial, qui ne conserve pas de base explicite.
+ * @param p Le problème.
+ * @return La solution creuse, NULL en cas d'erreur d'allocation.
+ */
+SolutionCreuse* extraireSolutionCreuse(ProblemeTransport* p);
+
+/**
+ * @brief Recopie une solution creuse dans la matrice dense B du problème.
+ * @param p Le problème (dimensions identiques à celles de la solution).
+ * @param s La solution à appliquer.
+ */
+void appliquerSolutionCreuse(ProblemeTransport* p, const SolutionCreuse* s);
+
+/**
+ * @brief Démarrage à chaud : solution de base associée à l'arbre d'une autre solution (mêmes cases de
+ * base) pour les offres et demandes de p. Les quantités sont obtenues en O(n+m) par élimination des
+ * feuilles de l'arbre ; la base n'est reprise que si toutes sont positives ou nulles.
+ * @param p Le problème (B en sortie, inchangée en cas d'échec ; problème non capacité).
+ * @param base Solution dont les n+m-1 cases forment un arbre couvrant (typiquement d'un produit voisin).
+ * @return false si la base n'est pas un arbre, a une case hors de la grille, donne une quantité négative,
+ * ou si p est capacité.
+ */
+bool appliquerBaseVoisine(ProblemeTransport* p, const SolutionCreuse* base);
+
+/**
+ * @brief Affiche la liste des cases de base (i, j, quantité, coût) et le coût total.
+ * Coût O(n+m) quelle que soit la taille de la matrice.
+ * @param s La solution à afficher.
+ */
+void afficherSolutionCreuse(const SolutionCreuse* s);
+
+/**
+ * @brief Attache des potentiels (certificat dual) à la solution, par copie.
+ * @param s La solution.
+ * @param E_s Potentiels des fournisseurs (taille s->n).
+ * @param E_t Potentiels des clients (taille s->m).
+ * @return false en cas d'erreur d'allocation.
+ */
+bool attacherPotentielsSolution(SolutionCreuse* s, const double* E_s, const double* E_t);
+
+/**
+ * @brief Vérifie un certificat d'optimalité, indépendamment du solveur.
+ * Admissibilité primale (O(cases + n + m)), admissibilité duale (O(n*m)) et écart de dualité nul.
+ * Problème capacité : une case plafonnée peut avoir un coût marginal négatif, compté dans l'objectif dual
+ * par le terme U[i][j] * min(0, coût marginal) ; la quantité doit alors être à la capacité.
+ * Convention : coût marginal = A[i][j] - (E_s[i] - E_t[j]) ; les prix duaux des contraintes
+ * sont E_s[i] pour l'offre i et -E_t[j] pour la demande j.
+ * @param p Le problème (A, P, C ; B n'est pas lue).
+ * @param s La solution, avec ses potentiels (E_s/E_t).
+ * @param tolerance Tolérance absolue sur les coûts marginaux, relative (1 + |Z|) sur l'écart.
+ * @param rapport Diagnostic détaillé (peut être NULL).
+ * @return true si la solution est prouvée optimale.
+ */
+bool verifierCertificatOptimalite(const ProblemeTransport* p, const SolutionCreuse* s,
+                                  double tolerance, RapportCertificat* rapport);
+
+/**
+ * @brief Exporte les potentiels au format CSV (en-tête : type,indice,potentiel ; type = s ou t).
+ * @param s La solution (doit porter ses potentiels).
+ * @param nomFichier Chemin du fichier de sortie.
+ * @return true si l'écriture a réussi, false si pas de potentiels ou erreur d'écriture.
+ */
+bool exporterDualeCSV(const SolutionCreuse* s, const char* nomFichier);
+
+/**
+ * @brief Exporte la solution au format CSV (en-tête : i,j,quantite,cout).
+ * @param s La solution.
+ * @param nomFichier Chemin du fichier de sortie.
+ * @return true si l'écriture a réussi.
+ */
+bool exporterSolutionCSV(const SolutionCreuse* s, const char* nomFichier);
+
+/**
+ * @brief Exporte la solution au format JSON ({n, m, cout_total, cases: [...]}).
+ * Si la solution porte ses potentiels, les tableaux E_s et E_t sont ajoutés.
+ * @param s La solution.
+ * @param nomFichier Chemin du fichier de sortie.
+ * @return true si l'écriture a réussi.
+ */
+bool exporterSolutionJSON(const SolutionCreuse* s, const char* nomFichier);
+
+/**
+ * @brief Exporte la solution au format binaire compact.
+ * Format (petit-boutiste natif) : "ROSC", version (u32), n, m, nb_cases (i32), cout_total (f64),
+ * puis nb_cases enregistrements (i, j, quantite : i32 ; cout : f64),
+ * puis un indicateur (i32) et, s'il vaut 1, les potentiels E_s (n f64) et E_t (m f64).
+ * @param s La solution.
+ * @param nomFichier Chemin du fichier de sortie.
+ * @return true si l'écriture a réussi.
+ */
+bool exporterSolutionBinaire(const SolutionCreuse* s, const char* nomFichier);
+
+/**
+ * @brief Écrit la solution au format de exporterSolutionBinaire dans un flux déjà ouvert.
+ * @return true si l'écriture a réussi (le flux n'est pas fermé).
+ */
+bool ecrireSolutionBinaire(const SolutionCreuse* s, FILE* f);
+
+/**
+ * @brief Lit une solution écrite par ecrireSolutionBinaire à la position courante du flux.
+ * @return La solution lue, NULL si le contenu est invalide (dimensions nulles ou négatives, case hors de la
+ * grille, quantité négative).
+ */
+SolutionCreuse* lireSolutionBinaireFlux(FILE* f);
+
+/**
+ * @brief Relit une solution écrite par exporterSolutionBinaire (versions 1 et 2).
+ * @param nomFichier Chemin du fichier.
+ * @return La solution lue, NULL si le fichier est absent ou invalide.
+ */
+SolutionCreuse* lireSolutionBinaire(const char* nomFichier);
+
+// ==========================================================
+// 9. PARALLELISME (POOL DE THREADS)
+// ==========================================================
+
+/**
+ * @brief Nombre de coeurs disponibles sur la machine.
+ * @return Nombre de processeurs en ligne (au moins 1).
+ */
+int nbCoeursDisponibles(void);
+
+/**
+ * @brief Crée un pool de threads persistant, réutilisé d'un lot de tâches à l'autre.
+ * Le thread appelant participe aux calculs : nb_threads - 1 threads auxiliaires sont créés.
+ * @param nb_threads Nombre de threads de calcul (<= 0 : nombre de coeurs).
+ * @return Le pool, NULL en cas d'erreur d'allocation.
+ */
+PoolThreads* creerPoolThreads(int nb_threads);
+
+/**
+ * @brief Arrête les threads du pool et libère ses ressources.
+ * @param pool Le pool (peut être NULL).
+ */
+void libererPoolThreads(PoolThreads* pool);
+
+/**
+ * @brief Nombre de threads de calcul du pool (1 si pool est NULL).
+ * @param pool Le pool.
+ * @return Nombre de threads, appelant compris.
+ */
+int nbThreadsPool(const PoolThreads* pool);
+
+/**
+ * @brief Exécute fonction(contexte, k, nb_taches) pour k = 0..nb_taches-1 sur le pool et attend la fin.
+ * Appelable depuis plusieurs threads : les lots d'un même pool sont exécutés l'un après l'autre.
+ * Ne pas appeler depuis une tâche du même pool (interblocage).
+ * @param pool Le pool (NULL : exécution séquentielle).
+ * @param nb_taches Nombre de tâches.
+ * @param fonction Fonction exécutée pour chaque tâche.
+ * @param contexte Données partagées passées à chaque tâche.
+ */
+void executerEnParallele(PoolThreads* pool, int nb_taches, TacheParallele fonction, void* contexte);
+
+/**
+ * @brief Version parallèle de calculerCoutsMarginaux : les lignes sont réparties en blocs sur le pool.
+ * La réduction parcourt les blocs dans l'ordre et garde le premier minimum strict : la case entrante
+ * est exactement celle du parcours séquentiel (même départage lexicographique).
+ * Bascule sur le calcul séquentiel si pool est NULL ou si l'instance est trop petite.
+ * @param p Le problème.
+ * @param base Cases de la base (ensembles de bits).
+ * @param E_s Tableau des potentiels des fournisseurs.
+ * @param E_t Tableau des potentiels des clients.
+ * @param i_ajout Pointeur pour stocker l'indice ligne de la variable entrante.
+ * @param j_ajout Pointeur pour stocker l'indice colonne de la variable entrante.
+ * @param couts_marginaux Matrice des coûts marginaux (sortie).
+ * @param pool Pool de threads.
+ * @return true si une amélioration est possible, false si optimal.
+ */
+bool calculerCoutsMarginauxParallele(ProblemeTransport* p, BaseBinaire* base, double* E_s, double* E_t,
+                                     int* i_ajout, int* j_ajout, double** couts_marginaux,
+                                     PoolThreads* pool);
+
+/**
+ * @brief Résolution en portefeuille : chaque méthode initiale + Marche-Pied s'exécute dans son propre thread,
+ * sur une vue privée du problème (creerProblemePartage). Le premier pipeline qui prouve l'optimalité gagne
+ * et les autres sont annulés de façon coopérative (options.annulation, testé à chaque pivot).
+ * Si aucun pipeline ne prouve l'optimalité (limites atteintes), la solution de plus petit coût est retenue.
+ * La solution retenue est recopiée dans p->B.
+ * @param p Le problème (seule sa matrice B est modifiée, à la fin).
+ * @param methodes Méthodes initiales à mettre en concurrence.
+ * @param nb_methodes Nombre de méthodes.
+ * @param options Options communes du Marche-Pied (trace, pool et annulation sont ignorés).
+ * @param resultat Informations sur le pipeline retenu (peut être NULL).
+ * @return La base retenue sous forme creuse (à libérer avec libererSolutionCreuse), NULL en cas d'erreur.
+ */
+SolutionCreuse* resoudrePortfolio(ProblemeTransport* p, const MethodeInitiale* methodes, int nb_methodes,
+                                  const OptionsMarchePied* options, ResultatPortfolio* resultat);
+
+/**
+ * @brief Résout plusieurs produits qui partagent la matrice A (et les capacités) du problème p.
+ * A et ses ordres triés (calculés une fois) sont partagés en lecture seule ; chaque thread traite un bloc
+ * contigu de produits avec sa propre matrice B. Dans un bloc, chaque produit repart de la base finale du
+ * produit précédent si elle reste admissible (appliquerBaseVoisine), sinon de la méthode initiale.
+ * @param p Problème portant A (ses P, C et B ne sont pas utilisés).
+ * @param produits Seconds membres ; solution, stats et demarrage_chaud renseignés en sortie.
+ * @param nb_produits Nombre de produits.
+ * @param methode Méthode initiale des démarrages à froid.
+ * @param options Options communes du Marche-Pied (trace, pool et resultat sont ignorés), NULL : défaut.
+ * @param nb_threads Nombre de threads (<= 0 : nombre de coeurs).
+ * @return false en cas d'erreur d'allocation (des produits peuvent alors rester sans solution).
+ */
+bool resoudreMultiProduits(const ProblemeTransport* p, ProduitTransport* produits, int nb_produits,
+                           MethodeInitiale methode, const OptionsMarchePied* options, int nb_threads);
+
+/**
+ * @brief Décomposition en blocs indépendants. Une liaison est fermée si son coût est >= seuil_interdit ou
+ * sa capacité nulle ; les composantes connexes du graphe fournisseurs/clients des liaisons ouvertes sont
+ * détectées par union-find en un parcours de A. Si chaque composante est équilibrée (offre = demande),
+ * chaque bloc devient un sous-problème résolu sur le pool (plus grands blocs d'abord), puis les solutions
+ * sont recopiées dans p->B. Un dernier Marche-Pied sur le problème complet part de cette solution : il
+ * prouve l'optimalité (en général sans pivot) ou corrige si un bloc a dû emprunter une liaison interdite.
+ * Sinon (une seule composante, ou composante déséquilibrée), résolution directe par resoudreAnytime.
+ * @param p Le problème (B en sortie).
+ * @param methode Méthode initiale des blocs.
+ * @param seuil_interdit Coût de fermeture d'une liaison (SEUIL_COUT_INTERDIT par défaut).
+ * @param options Options du Marche-Pied ; trace, pool et resultat ne servent qu'à la passe finale. NULL : défaut.
+ * @param nb_threads Threads de la phase par blocs (<= 0 : nombre de coeurs).
+ * @param bilan Bilan de la décomposition (peut être NULL).
+ * @return La solution creuse (à libérer), NULL en cas d'erreur d'allocation.
+ */
+SolutionCreuse* resoudreDecompose(ProblemeTransport* p, MethodeInitiale methode, double seuil_interdit,
+                                  const OptionsMarchePied* options, int nb_threads, ResultatDecomposition* bilan);
+
+// ==========================================================
+// 10. ANALYSE DE SENSIBILITE
+// ==========================================================
+
+/**
+ * @brief Calcule les plages de coûts de toutes les cases à partir de la base optimale.
+ * - Case hors base : A[i][j] peut baisser de son coût marginal, sans limite à la hausse.
+ * - Case de base : retirer la case coupe l'arbre en deux ; A[i][j] peut varier tant qu'aucune case
+ *   hors base traversant la coupe ne devient négative. Chaque case hors base met à jour les cases de
+ *   base du chemin qui relie ses deux extrémités dans l'arbre : coût O(n*m*profondeur) au total.
+ * @param p Le problème (A).
+ * @param sol Solution optimale portant ses potentiels (n+m-1 cases formant un arbre : problème non capacité).
+ * @return L'analyse (à libérer), NULL si la solution n'a pas de potentiels, n'est pas un arbre ou erreur d'allocation.
+ */
+AnalyseSensibilite* analyserSensibilite(const ProblemeTransport* p, const SolutionCreuse* sol);
+
+/**
+ * @brief Libère une analyse de sensibilité.
+ * @param a L'analyse (peut être NULL).
+ */
+void libererAnalyseSensibilite(AnalyseSensibilite* a);
+
+/**
+ * @brief Plage du second membre : P[i] et C[j] augmentés ensemble de delta (l'équilibre est conservé).
+ * Les delta unités suivent le chemin de F_i à C_j dans l'arbre ; la base reste admissible tant qu'aucune
+ * quantité du chemin ne devient négative. Coût O(profondeur).
+ * @param a L'analyse.
+ * @param i Indice du fournisseur.
+ * @param j Indice du client.
+ * @param delta_min Plus petite variation admissible (sortie, <= 0).
+ * @param delta_max Plus grande variation admissible (sortie, INT_MAX si illimitée).
+ * @return Variation du coût optimal par unité de delta (E_s[i] - E_t[j]).
+ */
+double plageSecondMembre(const AnalyseSensibilite* a, int i, int j, int* delta_min, int* delta_max);
+
+/**
+ * @brief Affiche les plages de coûts des cases de base (et des cases hors base si n*m <= 100).
+ * @param p Le problème.
+ * @param sol La solution analysée.
+ * @param a L'analyse.
+ */
+void afficherAnalyseSensibilite(const ProblemeTransport* p, const SolutionCreuse* sol, const AnalyseSensibilite* a);
+
+// ==========================================================
+// 11. TRANSBORDEMENT (RESEAU GENERAL)
+// ==========================================================
+
+/**
+ * @brief Crée un réseau vide (offres nulles, aucun arc).
+ * @param nb_noeuds Nombre de noeuds (> 0).
+ * @param capacite_arcs Taille initiale des tableaux d'arcs (agrandis si nécessaire).
+ * @return Le réseau, NULL en cas d'erreur d'allocation.
+ */
+ReseauTransbordement* creerReseau(int nb_noeuds, int capacite_arcs);
+
+/**
+ * @brief Libère un réseau.
+ * @param r Le réseau (peut être NULL).
+ */
+void libererReseau(ReseauTransbordement* r);
+
+/**
+ * @brief Ajoute l'arc u -> v (flux nul).
+ * @param capacite Capacité de l'arc (INT_MAX : non plafonné).
+ * @return false si un noeud est hors limites, u == v, capacité négative ou erreur d'allocation.
+ */
+bool ajouterArc(ReseauTransbordement* r, int u, int v, double cout, int capacite);
+
+/**
+ * @brief Lit un réseau : "N K", puis les N offres, puis K lignes "u v cout capacite" (capacite -1 : non plafonné).
+ * @return Le réseau, NULL si le fichier est illisible ou invalide.
+ */
+ReseauTransbordement* lireReseau(const char* nomFichier);
+
+/**
+ * @brief Réseau équivalent à un problème de transport : F_i = noeud i, C_j = noeud n+j, arcs F_i -> C_j.
+ * Les capacités du problème (p->U) sont reportées sur les arcs.
+ * @return Le réseau, NULL en cas d'erreur d'allocation.
+ */
+ReseauTransbordement* reseauDepuisProbleme(const ProblemeTransport* p);
+
+/**
+ * @brief Simplexe des réseaux : même principe que le Marche-Pied (potentiels de l'arbre de base, pivot le
+ * long du cycle formé par l'arc entrant) sur un arbre couvrant stocké par parents, sans matrice dense.
+ * - Base initiale : racine artificielle reliée à chaque noeud par un arc de coût prohibitif ;
+ * - Arc entrant : recherche par blocs de taille ~racine(nb_arcs), le meilleur arc du premier bloc
+ *   contenant un candidat (une itération ne parcourt pas tous les arcs) ;
+ * - Arc sortant : dernier arc bloquant du cycle depuis son sommet (arbre fortement admissible, pas de
+ *   cyclage sur les pas dégénérés) ;
+ * - Mise à jour : seul le sous-arbre détaché est raccroché, ses potentiels sont décalés d'une constante.
+ * @param r Le réseau (flux et potentiels en sortie).
+ * @param o Options (max_iterations, delai_max, annulation et resultat ; les autres champs sont ignorés). NULL : défaut.
+ * @return true si le flux renvoyé respecte offres, demandes et capacités (optimalité : o->resultat),
+ * false si le réseau est déséquilibré, irréalisable, non borné (cycle de coût négatif non plafonné) ou erreur.
+ */
+bool resoudreTransbordement(ReseauTransbordement* r, const OptionsMarchePied* o);
+
+/**
+ * @brief Coût total du flux courant (somme flux * coût).
+ */
+double coutReseau(const ReseauTransbordement* r);
+
+/**
+ * @brief Affiche les arcs de flux non nul (100 au plus) et le coût total.
+ */
+void afficherFluxReseau(const ReseauTransbordement* r);
+
+// ==========================================================
+// 12. BIBLIOTHEQUE (POIGNEE DE SOLVEUR)
+// ==========================================================
+// Point d'entrée pour intégrer le solveur dans un autre programme : aucune écriture sur stdout,
+// aucun exit(), aucun état global. Des poignées distinctes s'utilisent en parallèle depuis autant
+// de threads ; une même poignée ne doit pas être utilisée par deux threads à la fois.
+
+/**
+ * @brief Remplit les options avec les valeurs par défaut (Balas-Hammer, 5000 pivots, séquentiel).
+ */
+void optionsSolveurParDefaut(OptionsSolveur* o);
+
+/**
+ * @brief Crée un solveur pour un problème n x m.
+ * @param couts Matrice des coûts, n*m valeurs ligne par ligne (couts[i*m + j] = A[i][j]).
+ * @param offres n offres (>= 0).
+ * @param demandes m demandes (>= 0), de même somme que les offres.
+ * @param sortie Reçoit la poignée (NULL en cas d'erreur).
+ */
+CodeRetour creerSolveur(int n, int m, const double* couts, const int* offres, const int* demandes,
+                        SolveurTransport** sortie);
+
+/**
+ * @brief Libère le solveur, sa solution et son pool.
+ */
+void libererSolveur(SolveurTransport* s);
+
+/**
+ * @brief Définit les capacités des cases plafonnées (nb = 0 : les supprime). Voir definirCapacites.
+ */
+CodeRetour definirCapacitesSolveur(SolveurTransport* s, int nb, const int* lignes, const int* colonnes,
+                                   const int* capacites);
+
+/**
+ * @brief Remplace la matrice des coûts (n*m valeurs ligne par ligne). La dernière solution reste
+ * consultable ; avec reprendre_base, la résolution suivante repart de sa base.
+ */
+CodeRetour modifierCoutsSolveur(SolveurTransport* s, const double* couts);
+
+/**
+ * @brief Modifie le coût de nb cases (A[lignes[k]][colonnes[k]] = couts[k]) en O(nb), sans
+ * recopier la matrice. Les ordres triés de A sont invalidés.
+ */
+CodeRetour modifierCasesSolveur(SolveurTransport* s, int nb, const int* lignes, const int* colonnes,
+                                const double* couts);
+
+/**
+ * @brief Résout le problème : méthode initiale (ou base précédente) puis Marche-Pied.
+ * @param o Options (NULL : valeurs par défaut).
+ * @return RETOUR_OK si optimal, RETOUR_ARRET_ANTICIPE si une solution admissible est disponible sans
+ * preuve d'optimalité, un code d'erreur sinon (la solution précédente est alors supprimée).
+ */
+CodeRetour resoudreSolveur(SolveurTransport* s, const OptionsSolveur* o);
+
+/**
+ * @brief Dernière solution obtenue (appartient au solveur), NULL si aucune.
+ */
+const SolutionCreuse* solutionSolveur(const SolveurTransport* s);
+
+/**
+ * @brief Statistiques de la dernière résolution (pivots, cause d'arrêt, écart à l'optimum).
+ */
+const ResultatMarchePied* resultatSolveur(const SolveurTransport* s);
+
+/**
+ * @brief Libellé d'un code de retour ("ok", "memoire", ...).
+ */
+const char* messageRetour(CodeRetour code);
+
+// ==========================================================
+// 13. DEMON (SOCKET UNIX, PROTOCOLE BINAIRE)
+// ==========================================================
+// Le démon garde les instances chargées (une poignée de solveur par instance) et un pool de threads
+// résidents. Chaque message commence par un EnteteMessage ; les entiers et réels sont transmis dans
+// l'ordre d'octets de la machine (socket locale). Charges utiles :
+//   CHARGER        : int32 n, m ; double couts[n*m] (ligne par ligne) ; int32 offres[n], demandes[m]
+//   MODIFIER_COUTS : int32 nb ; nb x CoutModifie
+//   RESOUDRE       : ParametresResolution
+// Réponses : même entête (code = CodeRetour) ; RESOUDRE renvoie EnteteSolution puis nb_cases x CaseTransmise
+// (sans charge utile si aucune solution n'est disponible).
+
+#define PROTOCOLE_MAGIE 0x31524F50u       // "POR1"
+#define PROTOCOLE_TAILLE_MAX (1u << 30)   // Charge utile maximale acceptée (octets)
+
+typedef enum {
+    REQUETE_CHARGER = 1,    // Charge une instance, renvoie son identifiant
+    REQUETE_MODIFIER_COUTS, // Modifie des coûts de l'instance
+    REQUETE_RESOUDRE,       // Résout (ou re-résout à chaud) l'instance, renvoie la solution creuse
+    REQUETE_LIBERER,        // Libère l'instance
+    REQUETE_ARRETER         // Arrête le démon
+} TypeRequete;
+
+typedef struct {
+    uint32_t magie;    // PROTOCOLE_MAGIE
+    uint32_t type;     // TypeRequete (la réponse reprend celui de la requête)
+    uint32_t instance; // Identifiant de l'instance (attribué par CHARGER)
+    int32_t code;      // Réponse : CodeRetour (0 dans une requête)
+    uint32_t taille;   // Octets de charge utile qui suivent
+} EnteteMessage;
+
+typedef struct {
+    int32_t i, j;
+    double cout;
+} CoutModifie;
+
+typedef struct {
+    int32_t methode;        // MethodeInitiale
+    int32_t reprendre_base; // Repartir de la base précédente de l'instance
+    int32_t max_iterations;
+    int32_t reserve;
+    double delai_max;       // Secondes (0 : aucune échéance)
+} ParametresResolution;
+
+typedef struct {
+    double cout_total;
+    double ecart_max;
+    int32_t n, m;
+    int32_t pivots;
+    int32_t optimal;
+    int32_t cause;          // CauseArret
+    int32_t nb_cases;
+} EnteteSolution;
+
+typedef struct {
+    int32_t i, j, quantite, reserve;
+    double cout;            // A[i][j] au moment de la résolution
+} CaseTransmise;
+
+/**
+ * @brief Lance le démon sur la socket Unix `chemin` (recréée si c'est une socket) ; une connexion = un thread.
+ * Les requêtes d'une même instance sont exécutées une à la fois, celles d'instances différentes en parallèle.
+ * Rend la main après une requête ARRETER.
+ * @param nb_threads Threads du pool partagé par toutes les résolutions (1 : séquentiel, 0 : tous les coeurs).
+ * @param cache Cache partagé par toutes les instances (NULL : aucun), appartient à l'appelant.
+ * @return false si la socket ne peut pas être créée ou si `chemin` existe sans être une socket.
+ */
+bool lancerDemon(const char* chemin, int nb_threads, CacheSolutions* cache);
+
+/**
+ * @brief Se connecte au démon. @return Le descripteur de la connexion, -1 en cas d'erreur.
+ */
+int connecterDemon(const char* chemin);
+
+/**
+ * @brief Ferme une connexion ouverte par connecterDemon.
+ */
+void deconnecterDemon(int fd);
+
+/**
+ * @brief Envoie le problème p au démon. @param instance Reçoit l'identifiant de l'instance.
+ */
+CodeRetour demanderChargement(int fd, const ProblemeTransport* p, uint32_t* instance);
+
+/**
+ * @brief Modifie nb coûts de l'instance (voir modifierCasesSolveur).
+ */
+CodeRetour demanderModificationCouts(int fd, uint32_t instance, int nb, const CoutModifie* couts);
+
+/**
+ * @brief Résout l'instance (options : methode, reprendre_base, max_iterations, delai_max ; NULL : défaut).
+ * @param solution Reçoit la solution creuse (à libérer, NULL si aucune).
+ * @param stats Statistiques de la résolution (NULL : non demandées ; seuls cout_total, ecart_max,
+ * pivots, optimal et cause sont transmis).
+ */
+CodeRetour demanderResolution(int fd, uint32_t instance, const OptionsSolveur* o,
+                              SolutionCreuse** solution, ResultatMarchePied* stats);
+
+/**
+ * @brief Libère l'instance côté démon.
+ */
+CodeRetour demanderLiberation(int fd, uint32_t instance);
+
+/**
+ * @brief Demande l'arrêt du démon.
+ */
+CodeRetour demanderArret(int fd);
+
+// ==========================================================
+// 14. CACHE DE SOLUTIONS
+// ==========================================================
+// Les solutions optimales sont rangées sous deux empreintes de 64 bits : celle de (n, m, A) et celle de
+// l'instance complète (A, P, C, U). Même instance : la solution est resservie après vérification de son
+// certificat (O(n*m), aucun pivot). Même A, seconds membres différents : la base en cache sert de
+// démarrage à chaud (appliquerBaseVoisine). Le cache est protégé par un verrou interne.
+
+#define TAILLE_CACHE_DEFAUT 64 // Entrées du cache de --cache et du démon
+
+typedef struct {
+    uint64_t probleme; // Empreinte de l'instance complète
+    uint64_t couts;    // Empreinte de (n, m, A)
+} EmpreinteProbleme;
+
+typedef enum {
+    CACHE_ABSENT,  // Aucune solution pour cette matrice de coûts
+    CACHE_VOISIN,  // Même matrice, seconds membres ou capacités différents
+    CACHE_EXACT    // Même instance
+} ResultatCache;
+
+typedef struct {
+    long exacts, voisins, absents; // Résultats des recherches
+    long evictions;                // Entrées évincées (LRU)
+    int entrees;                   // Entrées occupées
+} StatistiquesCache;
+
+/**
+ * @brief Empreintes de l'instance, en un parcours de A (quatre états de hachage indépendants).
+ */
+EmpreinteProbleme empreinteProbleme(const ProblemeTransport* p);
+
+/**
+ * @brief Crée un cache de capacite entrées. @return NULL si capacite <= 0 ou erreur d'allocation.
+ */
+CacheSolutions* creerCacheSolutions(int capacite);
+
+/**
+ * @brief Libère le cache et ses solutions.
+ */
+void libererCacheSolutions(CacheSolutions* c);
+
+/**
+ * @brief Cherche l'instance : entrée exacte, sinon la plus récente de même matrice A.
+ * @param copie Reçoit une copie de la solution trouvée (à libérer), NULL si absente.
+ */
+ResultatCache chercherCache(CacheSolutions* c, const EmpreinteProbleme* e, SolutionCreuse** copie);
+
+/**
+ * @brief Range une copie de la solution (remplace l'entrée de même empreinte, sinon évince la moins
+ * récemment utilisée). @return false en cas d'erreur d'allocation.
+ */
+bool ajouterCache(CacheSolutions* c, const EmpreinteProbleme* e, const SolutionCreuse* s);
+
+/**
+ * @brief Compteurs de recherches et d'évictions depuis la création.
+ */
+StatistiquesCache statistiquesCache(CacheSolutions* c);
+
+/**
+ * @brief Sauvegarde le cache : "ROCA", nombre d'entrées (i32), puis pour chaque entrée, de la moins
+ * à la plus récente, ses empreintes (2 x u64) et sa solution (format de exporterSolutionBinaire).
+ */
+bool sauverCacheSolutions(CacheSolutions* c, const char* nomFichier);
+
+/**
+ * @brief Résolution appuyée sur le cache : instance connue servie sans pivot, sinon Marche-Pied depuis
+ * base_chaude (si elle reste admissible), puis depuis la base en cache de même matrice A, sinon depuis la
+ * méthode initiale (resoudreAnytime). Une solution prouvée optimale est ajoutée au cache.
+ * @param base_chaude Base proposée par l'appelant (NULL : aucune).
+ * @param o Options du Marche-Pied (o->resultat reçoit les statistiques), NULL : défaut.
+ * @param origine Reçoit CACHE_EXACT, CACHE_VOISIN (base du cache utilisée) ou CACHE_ABSENT (peut être NULL).
+ * @return La solution (à libérer), NULL en cas d'erreur d'allocation.
+ */
+SolutionCreuse* resoudreAvecCache(ProblemeTransport* p, CacheSolutions* c, MethodeInitiale methode,
+                                  const SolutionCreuse* base_chaude, const OptionsMarchePied* o,
+                                  ResultatCache* origine);
+
+/**
+ * @brief Ajoute au cache les entrées d'un fichier écrit par sauverCacheSolutions.
+ * @return false si le fichier est absent ou invalide (les entrées déjà lues sont conservées).
+ */
+bool chargerCacheSolutions(CacheSolutions* c, const char* nomFichier);
+
+// ==========================================================
+// 15. REDUCTION DU PROBLEME (PRESOLVE / POSTSOLVE)
+// ==========================================================
+// Réductions appliquées avant la solution initiale, dans cet ordre :
+// - lignes d'offre nulle et colonnes de demande nulle supprimées ;
+// - affectations forcées : une ligne (colonne) dont les liaisons ouvertes n'acheminent l'offre que d'une
+//   façon (une seule liaison ouverte, ou des liaisons plafonnées de capacité totale égale à l'offre) est
+//   fixée puis retirée, jusqu'à ce que plus rien ne soit forcé ;
+// - clients de colonnes de coûts identiques fusionnés (demandes sommées), puis fournisseurs de lignes
+//   identiques. Une ligne ou colonne portant une case plafonnée active n'est jamais fusionnée.
+// Le coût d'une case du problème réduit est celui de chacun de ses membres : une répartition quelconque
+// du flux entre membres a le même coût, restaurerSolution choisit celle du coin nord-ouest.
+
+/**
+ * @brief Bilan d'une réduction (voir reduireProbleme et resoudreReduit).
+ */
+typedef struct {
+    bool reduit;             // true si le problème réduit a servi (false : rien à réduire ou résolution directe)
+    int lignes_supprimees;   // Offre nulle, ou soldée par des affectations forcées
+    int colonnes_supprimees; // Demande nulle, ou soldée par des affectations forcées
+    int lignes_fusionnees;   // Fournisseurs absorbés par un fournisseur de coûts identiques
+    int colonnes_fusionnees; // Clients absorbés par un client de coûts identiques
+    int cases_fixees;        // Affectations forcées
+    int n_reduit, m_reduit;  // Dimensions du problème réduit
+    int pivots_reduit;       // Pivots du Marche-Pied sur le problème réduit
+    double duree_reduit;     // Réduction, résolution réduite et reconstruction (secondes, horloge murale)
+} ResultatReduction;
+
+/**
+ * @brief Problème réduit et table de reconstruction (postsolve) vers le problème d'origine.
+ */
+typedef struct {
+    int n, m;                  // Dimensions d'origine
+    ProblemeTransport* reduit; // Problème réduit (NULL : tout est acheminé par les affectations forcées)
+    int* ligne_reduite;        // n : ligne réduite de chaque fournisseur (-1 : supprimé)
+    int* colonne_reduite;      // m : colonne réduite de chaque client (-1 : supprimé)
+    int* offre_residuelle;     // n : offre après affectations forcées (part du fournisseur dans son groupe)
+    int* demande_residuelle;   // m : demande après affectations forcées
+    CaseBase* fixees;          // Affectations forcées, quantités comprises
+    int nb_fixees;
+    ResultatReduction bilan;   // Réductions appliquées (n_reduit, m_reduit, ...)
+} ReductionProbleme;
+
+/**
+ * @brief Réduit le problème (A, P, C et capacités lus, B ignorée). Coût : un parcours de A pour les
+ * empreintes des colonnes puis des lignes, plus les comparaisons exactes entre candidats à la fusion.
+ * @return La réduction (à libérer avec libererReduction), NULL si le problème est déséquilibré ou en cas
+ * d'erreur d'allocation.
+ */
+ReductionProbleme* reduireProbleme(const ProblemeTransport* p);
+
+/**
+ * @brief Reconstruit p->B à partir de r->reduit->B : affectations forcées, puis flux de chaque case
+ * réduite ventilés au coin nord-ouest sur les clients, puis sur les fournisseurs de leurs groupes.
+ * Une base du problème réduit donne une forêt (sans cycle) du problème complet.
+ * @return false si la solution réduite ne respecte pas ses offres / demandes ou en cas d'erreur d'allocation.
+ */
+bool restaurerSolution(const ReductionProbleme* r, ProblemeTransport* p);
+
+void libererReduction(ReductionProbleme* r);
+
+/**
+ * @brief Réduction, résolution du problème réduit (resoudreAnytime), reconstruction de B, puis Marche-Pied
+ * sur le problème complet depuis cette solution : il complète la base, calcule les potentiels et prouve
+ * l'optimalité (en général sans pivot). Si rien n'est réductible, résolution directe.
+ * @param options Options du Marche-Pied ; trace et resultat ne servent qu'à la passe finale. NULL : défaut.
+ * @param bilan Bilan de la réduction (peut être NULL).
+ * @return La solution creuse (à libérer), NULL en cas d'erreur d'allocation.
+ */
+SolutionCreuse* resoudreReduit(ProblemeTransport* p, MethodeInitiale methode, const OptionsMarchePied* options,
+                               ResultatReduction* bilan);
+
+// ==========================================================
+// 16. COMPTEURS MATERIELS (PERF_EVENT_OPEN)
+// ==========================================================
+// Cycles, instructions, lectures manquées du dernier niveau de cache et branchements mal prédits du thread
+// appelant, lus en groupe (un appel système par lecture). Linux uniquement ; ailleurs, ou si le noyau
+// refuse (perf_event_paranoid > 2, machine virtuelle sans PMU), ouvrirCompteursMateriels renvoie NULL.
+// Chaque lecture coûte un appel système : les temps mesurés en même temps en sont gonflés.
+
+typedef enum {
+    COMPTEUR_CYCLES,
+    COMPTEUR_INSTRUCTIONS,
+    COMPTEUR_DEFAUTS_LLC,
+    COMPTEUR_BRANCHEMENTS_RATES,
+    NB_COMPTEURS_MATERIELS
+} CompteurMateriel;
+
+typedef enum {
+    PHASE_METHODE_INITIALE,  // Nord-Ouest, Balas-Hammer, ... (mesurée par l'appelant)
+    PHASE_MARCHE_PIED,       // Marche-Pied complet (mesuré par l'appelant)
+    PHASE_POTENTIELS,        // Dans le Marche-Pied : calculerPotentiels
+    PHASE_COUTS_MARGINAUX,   // Dans le Marche-Pied : coûts marginaux et choix de l'entrante
+    PHASE_CYCLE,             // Dans le Marche-Pied : recherche du cycle et pivot
+    NB_PHASES_MESUREES
+} PhaseMesuree;
+
+typedef struct {
+    uint64_t valeurs[NB_COMPTEURS_MATERIELS]; // Indexées par CompteurMateriel
+    uint64_t temps_actif;   // ns pendant lesquels le groupe était activé
+    uint64_t temps_compte;  // ns pendant lesquels il occupait la PMU (< temps_actif : valeurs extrapolées)
+} MesureMaterielle;
+
+/**
+ * @brief Ouvre et démarre le groupe de compteurs du thread appelant.
+ * @return NULL si les compteurs matériels sont indisponibles ou en cas d'erreur d'allocation.
+ */
+CompteursMateriels* ouvrirCompteursMateriels(void);
+
+void fermerCompteursMateriels(CompteursMateriels* c);
+
+/**
+ * @brief Relève les compteurs au début d'une phase (depart est fourni par l'appelant).
+ */
+void debuterPhase(CompteursMateriels* c, MesureMaterielle* depart);
+
+/**
+ * @brief Ajoute au cumul de la phase les événements survenus depuis depart. Si le noyau a multiplexé
+ * le groupe, les événements sont mis à l'échelle par temps_actif / temps_compte de l'intervalle.
+ */
+void terminerPhase(CompteursMateriels* c, PhaseMesuree phase, const MesureMaterielle* depart);
+
+void remettreCompteursAZero(CompteursMateriels* c);
+
+/**
+ * @brief Cumul d'une phase depuis la dernière remise à zéro.
+ */
+const MesureMaterielle* cumulPhase(const CompteursMateriels* c, PhaseMesuree phase);
+
+// ==========================================================
+// 17. PROFIL MEMOIRE
+// ==========================================================
+// Compilé avec -DPROFIL_MEMOIRE (glibc), memoire.c remplace malloc, calloc, realloc, free et les
+// allocations alignées par des versions qui délèguent à la glibc et, pour le seul thread qui a appelé
+// debuterProfilMemoire, comptent les allocations et suivent le tas vivant (malloc_usable_size).
+// Sans ce drapeau (défaut : bibliothèque, démon, CLI), l'allocateur n'est pas remplacé : le profil donne
+// le solde du tas (mallinfo2) et un pic estimé par la croissance de la mémoire résidente, pour le
+// processus entier. Le pic de mémoire résidente (VmHWM) est celui du processus ; Linux uniquement.
+
+typedef struct {
+    long nb_allocations;     // Allocations réussies (0 sans -DPROFIL_MEMOIRE)
+    size_t octets_alloues;   // Cumul des tailles demandées (0 sans -DPROFIL_MEMOIRE)
+    long long octets_vivants; // Tas vivant depuis debuterProfilMemoire (blocs antérieurs libérés : négatif)
+    long long pic_octets;    // Tas supplémentaire au plus fort de l'exécution (estimé sans -DPROFIL_MEMOIRE)
+} ProfilMemoire;
+
+/**
+ * @brief true si les allocations sont comptées (-DPROFIL_MEMOIRE avec la glibc) ; sinon seuls le solde et le
+ * pic estimé sont renseignés.
+ */
+bool profilMemoireDisponible(void);
+
+/**
+ * @brief Remet à zéro et active le profil du thread appelant.
+ */
+void debuterProfilMemoire(void);
+
+/**
+ * @brief Désactive le profil du thread appelant et le renvoie.
+ */
+ProfilMemoire terminerProfilMemoire(void);
+
+/**
+ * @brief Rend le tas libre au système (malloc_trim) puis ramène le pic de mémoire résidente du processus à
+ * sa valeur courante (/proc/self/clear_refs).
+ */
+void reinitialiserPicResident(void);
+
+/**
+ * @brief Pic de mémoire résidente du processus en Ko depuis la dernière remise à zéro (0 : indisponible).
+ */
+long picResidentKo(void);
 
 #endif
@@ -0,0 +1,496 @@
+/**
+ * @file reduction.c
+ * @brief Réduction de l'instance avant résolution (presolve) et reconstruction de B (postsolve).
+ * Les lignes et colonnes vides disparaissent, les affectations forcées sont fixées, les clients puis les
+ * fournisseurs de coûts identiques sont fusionnés ; la solution du problème réduit est ensuite ventilée
+ * sur les lignes et colonnes d'origine.
+ */
+
+#include "projet_ro.h"
+
+typedef struct {
+    const ProblemeTransport* p;
+    int* offre;              // Offres résiduelles (0 : ligne supprimée)
+    int* demande;            // Demandes résiduelles (0 : colonne supprimée)
+    int nb_lignes;           // Lignes encore actives
+    int nb_colonnes;         // Colonnes encore actives
+    int* debut_col;          // Capacités transposées par colonne (CSC), NULL sans capacités
+    int* ligne_col;
+    int* capacite_col;
+    CaseBase* fixees;        // Affectations forcées
+    int nb_fixees;
+} EtatReduction;
+
+// ==========================================================
+// 1. AFFECTATIONS FORCEES
+// ==========================================================
+
+/**
+ * @brief Transpose les capacités (CSR par ligne) en CSC par colonne pour les tests des colonnes.
+ */
+static bool transposerCapacites(EtatReduction* e) {
+    const CapacitesCreuses* U = e->p->U;
+    int n = e->p->n, m = e->p->m;
+    e->debut_col = (int*)calloc(m + 1, sizeof(int));
+    e->ligne_col = (int*)malloc((U->nb + 1) * sizeof(int));
+    e->capacite_col = (int*)malloc((U->nb + 1) * sizeof(int));
+    int* remplis = (int*)calloc(m, sizeof(int));
+    bool ok = e->debut_col && e->ligne_col && e->capacite_col && remplis;
+    if (ok) {
+        for (int k = 0; k < U->nb; k++) e->debut_col[U->colonne[k] + 1]++;
+        for (int j = 0; j < m; j++) e->debut_col[j + 1] += e->debut_col[j];
+        for (int i = 0; i < n; i++)
+            for (int k = U->debut[i]; k < U->debut[i + 1]; k++) {
+                int j = U->colonne[k], pos = e->debut_col[j] + remplis[j]++;
+                e->ligne_col[pos] = i;
+                e->capacite_col[pos] = U->capacite[k];
+            }
+    }
+    free(remplis);
+    return ok;
+}
+
+/**
+ * @brief Fixe q unités sur la case (i, j) et retire la ligne / la colonne soldée.
+ */
+static void fixerCase(EtatReduction* e, int i, int j, int q) {
+    CaseBase* c = &e->fixees[e->nb_fixees++];
+    c->i = i; c->j = j; c->quantite = q; c->cout = e->p->A[i][j];
+    e->offre[i] -= q;
+    e->demande[j] -= q;
+    if (e->offre[i] == 0) e->nb_lignes--;
+    if (e->demande[j] == 0) e->nb_colonnes--;
+}
+
+/**
+ * @brief Fixe la ligne x (ou la colonne x) si ses liaisons ouvertes n'acheminent son offre que d'une façon :
+ * une seule liaison ouverte, ou uniquement des liaisons plafonnées dont les capacités somment à l'offre.
+ * Une affectation qui dépasserait la demande d'en face est laissée au solveur (irréalisable).
+ * @return true si la ligne (colonne) a été soldée.
+ */
+static bool fixerSiForcee(EtatReduction* e, bool par_colonne, int x) {
+    const ProblemeTransport* p = e->p;
+    int* reste = par_colonne ? e->demande : e->offre;
+    const int* reste_autre = par_colonne ? e->offre : e->demande;
+    int nb_autres = par_colonne ? e->nb_lignes : e->nb_colonnes;
+    int nb_total = par_colonne ? p->n : p->m;
+    int debut = 0, fin = 0;
+    const int* voisin = NULL;
+    const int* capacite = NULL;
+    if (p->U) {
+        debut = par_colonne ? e->debut_col[x] : p->U->debut[x];
+        fin = par_colonne ? e->debut_col[x + 1] : p->U->debut[x + 1];
+        voisin = par_colonne ? e->ligne_col : p->U->colonne;
+        capacite = par_colonne ? e->capacite_col : p->U->capacite;
+    }
+
+    int plafonnees = 0, ouvertes = 0, cible = -1, capacite_cible = INT_MAX;
+    long somme = 0;
+    for (int k = debut; k < fin; k++) {
+        if (reste_autre[voisin[k]] == 0) continue;
+        plafonnees++;
+        if (capacite[k] > 0) { ouvertes++; somme += capacite[k]; cible = voisin[k]; capacite_cible = capacite[k]; }
+    }
+    int libres = nb_autres - plafonnees; // Liaisons actives non plafonnées
+
+    if (libres + ouvertes == 1) {
+        if (libres == 1) {
+            capacite_cible = INT_MAX;
+            for (int y = 0; y < nb_total && cible < 0; y++) {
+                if (reste_autre[y] == 0) continue;
+                if ((par_colonne ? capaciteCase(p, y, x) : capaciteCase(p, x, y)) == INT_MAX) cible = y;
+            }
+        }
+        int q = reste[x];
+        if (cible < 0 || q > reste_autre[cible] || q > capacite_cible) return false;
+        if (par_colonne) fixerCase(e, cible, x, q);
+        else fixerCase(e, x, cible, q);
+        return true;
+    }
+
+    if (libres == 0 && ouvertes > 1 && somme == reste[x]) {
+        for (int k = debut; k < fin; k++)
+            if (reste_autre[voisin[k]] > 0 && capacite[k] > reste_autre[voisin[k]]) return false;
+        for (int k = debut; k < fin; k++) {
+            int y = voisin[k], q = capacite[k];
+            if (reste_autre[y] == 0 || q == 0) continue;
+            if (par_colonne) fixerCase(e, y, x, q);
+            else fixerCase(e, x, y, q);
+        }
+        return true;
+    }
+    return false;
+}
+
+// ==========================================================
+// 2. FUSION DES LIGNES ET COLONNES IDENTIQUES
+// ==========================================================
+
+typedef struct {
+    uint64_t h;  // Empreinte des coûts sur les indices retenus
+    int x;       // Ligne ou colonne
+} SignatureCouts;
+
+static int comparerSignatures(const void* a, const void* b) {
+    const SignatureCouts* s = (const SignatureCouts*)a;
+    const SignatureCouts* t = (const SignatureCouts*)b;
+    if (s->h != t->h) return (s->h > t->h) - (s->h < t->h);
+    return (s->x > t->x) - (s->x < t->x);
+}
+
+/**
+ * @brief Coût de la case d'indice k dans la colonne x (par_colonne) ou la ligne x.
+ */
+static inline double coutCase(const ProblemeTransport* p, bool par_colonne, int x, int k) {
+    if (!par_colonne) return p->A[x][k];
+    const double* colonne = colonneCouts(p, x);
+    return colonne ? colonne[k] : p->A[k][x];
+}
+
+static bool coutsIdentiques(const ProblemeTransport* p, bool par_colonne, int x, int y,
+                            const int* indices, int nb_indices) {
+    for (int t = 0; t < nb_indices; t++)
+        if (coutCase(p, par_colonne, x, indices[t]) != coutCase(p, par_colonne, y, indices[t])) return false;
+    return true;
+}
+
+/**
+ * @brief Regroupe les lignes (colonnes) éligibles de coûts égaux sur indices : tri par empreinte, puis
+ * comparaison exacte avec les représentants de même empreinte. representant[x] reçoit le plus petit indice
+ * du groupe de x (x lui-même s'il n'est pas absorbé).
+ * @return Le nombre de lignes (colonnes) absorbées, -1 en cas d'erreur d'allocation.
+ */
+static int fusionnerIdentiques(const ProblemeTransport* p, bool par_colonne, const int* eligibles, int nb_eligibles,
+                               const int* indices, int nb_indices, int* representant) {
+    if (nb_eligibles < 2) return 0;
+    SignatureCouts* s = (SignatureCouts*)malloc(nb_eligibles * sizeof(SignatureCouts));
+    if (!s) return -1;
+    for (int t = 0; t < nb_eligibles; t++) {
+        int x = eligibles[t];
+        uint64_t h = 0x243F6A8885A308D3ull;
+        for (int k = 0; k < nb_indices; k++) {
+            double c = coutCase(p, par_colonne, x, indices[k]);
+            uint64_t bits;
+            if (c == 0.0) c = 0.0; // -0.0 et 0.0 sont égaux
+            memcpy(&bits, &c, sizeof(bits));
+            h = (h ^ bits) * 0x100000001B3ull;
+            h ^= h >> 29;
+        }
+        s[t].h = h;
+        s[t].x = x;
+    }
+    qsort(s, nb_eligibles, sizeof(SignatureCouts), comparerSignatures);
+
+    int absorbees = 0;
+    for (int debut = 0, fin; debut < nb_eligibles; debut = fin) {
+        for (fin = debut + 1; fin < nb_eligibles && s[fin].h == s[debut].h; fin++) {}
+        // Dans une même empreinte, tout indice est comparé aux représentants déjà rencontrés (collisions rares)
+        for (int t = debut + 1; t < fin; t++) {
+            for (int r = debut; r < t; r++) {
+                int x = s[r].x;
+                if (representant[x] != x || !coutsIdentiques(p, par_colonne, x, s[t].x, indices, nb_indices)) continue;
+                representant[s[t].x] = x;
+                absorbees++;
+                break;
+            }
+        }
+    }
+    free(s);
+    return absorbees;
+}
+
+/**
+ * @brief Une ligne (colonne) active est fusionnable si aucune de ses cases vers une colonne (ligne) active
+ * n'est plafonnée : les capacités restent ainsi attachées à une case unique du problème réduit.
+ */
+static int listerEligibles(const EtatReduction* e, bool par_colonne, int* eligibles) {
+    const ProblemeTransport* p = e->p;
+    const int* reste = par_colonne ? e->demande : e->offre;
+    const int* reste_autre = par_colonne ? e->offre : e->demande;
+    int nb_total = par_colonne ? p->m : p->n, nb = 0;
+    for (int x = 0; x < nb_total; x++) {
+        if (reste[x] == 0) continue;
+        bool plafonnee = false;
+        if (p->U) {
+            int debut = par_colonne ? e->debut_col[x] : p->U->debut[x];
+            int fin = par_colonne ? e->debut_col[x + 1] : p->U->debut[x + 1];
+            const int* voisin = par_colonne ? e->ligne_col : p->U->colonne;
+            for (int k = debut; k < fin && !plafonnee; k++) plafonnee = reste_autre[voisin[k]] > 0;
+        }
+        if (!plafonnee) eligibles[nb++] = x;
+    }
+    return nb;
+}
+
+// ==========================================================
+// 3. PROBLEME REDUIT
+// ==========================================================
+
+void libererReduction(ReductionProbleme* r) {
+    if (!r) return;
+    libererProbleme(r->reduit);
+    free(r->ligne_reduite); free(r->colonne_reduite);
+    free(r->offre_residuelle); free(r->demande_residuelle);
+    free(r->fixees);
+    free(r);
+}
+
+/**
+ * @brief Construit le problème réduit : une ligne (colonne) par groupe actif, coûts du représentant,
+ * offres (demandes) résiduelles sommées sur le groupe, capacités des cases actives recopiées.
+ */
+static bool construireReduit(ReductionProbleme* r, const ProblemeTransport* p, const int* lignes_rep,
+                             const int* colonnes_rep) {
+    int nr = r->bilan.n_reduit, mr = r->bilan.m_reduit;
+    ProblemeTransport* q = r->reduit = creerProbleme(nr, mr);
+    if (!q) return false;
+    for (int g = 0; g < nr; g++) {
+        const double* ligne = p->A[lignes_rep[g]];
+        for (int h = 0; h < mr; h++) q->A[g][h] = ligne[colonnes_rep[h]];
+    }
+    memset(q->P, 0, nr * sizeof(int));
+    memset(q->C, 0, mr * sizeof(int));
+    for (int i = 0; i < p->n; i++) if (r->ligne_reduite[i] >= 0) q->P[r->ligne_reduite[i]] += r->offre_residuelle[i];
+    for (int j = 0; j < p->m; j++) if (r->colonne_reduite[j] >= 0) q->C[r->colonne_reduite[j]] += r->demande_residuelle[j];
+
+    if (p->U) {
+        // Lignes et colonnes plafonnées ne sont jamais fusionnées : chaque case garde sa capacité
+        int* li = (int*)malloc((p->U->nb + 1) * sizeof(int));
+        int* co = (int*)malloc((p->U->nb + 1) * sizeof(int));
+        int* ca = (int*)malloc((p->U->nb + 1) * sizeof(int));
+        bool ok = li && co && ca;
+        int nb = 0;
+        for (int i = 0; ok && i < p->n; i++) {
+            if (r->ligne_reduite[i] < 0) continue;
+            for (int k = p->U->debut[i]; k < p->U->debut[i + 1]; k++) {
+                int j = p->U->colonne[k];
+                if (r->colonne_reduite[j] < 0) continue;
+                li[nb] = r->ligne_reduite[i]; co[nb] = r->colonne_reduite[j]; ca[nb++] = p->U->capacite[k];
+            }
+        }
+        ok = ok && definirCapacites(q, nb, li, co, ca);
+        free(li); free(co); free(ca);
+        if (!ok) return false;
+    }
+    return actualiserCouts(q);
+}
+
+ReductionProbleme* reduireProbleme(const ProblemeTransport* p) {
+    int n = p->n, m = p->m;
+    long solde = 0;
+    for (int i = 0; i < n; i++) solde += p->P[i];
+    for (int j = 0; j < m; j++) solde -= p->C[j];
+    if (solde != 0) return NULL;
+
+    ReductionProbleme* r = (ReductionProbleme*)calloc(1, sizeof(ReductionProbleme));
+    if (!r) return NULL;
+    r->n = n; r->m = m;
+    r->ligne_reduite = (int*)malloc(n * sizeof(int));
+    r->colonne_reduite = (int*)malloc(m * sizeof(int));
+    r->offre_residuelle = (int*)malloc(n * sizeof(int));
+    r->demande_residuelle = (int*)malloc(m * sizeof(int));
+    // Une affectation forcée solde une ligne ou une colonne, ou sature une case plafonnée
+    r->fixees = (CaseBase*)malloc((n + m + (p->U ? p->U->nb : 0)) * sizeof(CaseBase));
+    int taille = (n > m) ? n : m;
+    int* rep_ligne = (int*)malloc(n * sizeof(int));
+    int* rep_colonne = (int*)malloc(m * sizeof(int));
+    int* eligibles = (int*)malloc(taille * sizeof(int));
+    int* indices = (int*)calloc(taille, sizeof(int));
+    EtatReduction e;
+    memset(&e, 0, sizeof(e));
+    e.p = p;
+    e.offre = r->offre_residuelle;
+    e.demande = r->demande_residuelle;
+    e.fixees = r->fixees;
+    bool ok = r->ligne_reduite && r->colonne_reduite && r->offre_residuelle && r->demande_residuelle && r->fixees
+           && rep_ligne && rep_colonne && eligibles && indices && (!p->U || transposerCapacites(&e));
+
+    if (ok) {
+        memcpy(e.offre, p->P, n * sizeof(int));
+        memcpy(e.demande, p->C, m * sizeof(int));
+        for (int i = 0; i < n; i++) e.nb_lignes += (e.offre[i] > 0);
+        for (int j = 0; j < m; j++) e.nb_colonnes += (e.demande[j] > 0);
+
+        // Chaque affectation solde une ligne ou une colonne, ce qui peut en forcer d'autres
+        for (bool change = true; change; ) {
+            change = false;
+            for (int i = 0; i < n; i++) if (e.offre[i] > 0 && fixerSiForcee(&e, false, i)) change = true;
+            for (int j = 0; j < m; j++) if (e.demande[j] > 0 && fixerSiForcee(&e, true, j)) change = true;
+        }
+        r->nb_fixees = e.nb_fixees;
+
+        // Colonnes comparées sur les lignes actives, puis lignes sur les colonnes représentantes
+        for (int i = 0; i < n; i++) rep_ligne[i] = i;
+        for (int j = 0; j < m; j++) rep_colonne[j] = j;
+        int nb_indices = 0;
+        for (int i = 0; i < n; i++) if (e.offre[i] > 0) indices[nb_indices++] = i;
+        int colonnes = fusionnerIdentiques(p, true, eligibles, listerEligibles(&e, true, eligibles), indices,
+                                           nb_indices, rep_colonne);
+        nb_indices = 0;
+        for (int j = 0; j < m; j++) if (e.demande[j] > 0 && rep_colonne[j] == j) indices[nb_indices++] = j;
+        int lignes = (colonnes < 0) ? -1
+                   : fusionnerIdentiques(p, false, eligibles, listerEligibles(&e, false, eligibles), indices,
+                                         nb_indices, rep_ligne);
+        ok = colonnes >= 0 && lignes >= 0;
+        r->bilan.colonnes_fusionnees = colonnes;
+        r->bilan.lignes_fusionnees = lignes;
+    }
+
+    if (ok) {
+        // Numérotation : le représentant (plus petit indice) précède toujours les membres de son groupe
+        int nr = 0, mr = 0;
+        for (int i = 0; i < n; i++) {
+            if (e.offre[i] == 0) { r->ligne_reduite[i] = -1; r->bilan.lignes_supprimees++; }
+            else if (rep_ligne[i] == i) { eligibles[nr] = i; r->ligne_reduite[i] = nr++; }
+            else r->ligne_reduite[i] = r->ligne_reduite[rep_ligne[i]];
+        }
+        for (int j = 0; j < m; j++) {
+            if (e.demande[j] == 0) { r->colonne_reduite[j] = -1; r->bilan.colonnes_supprimees++; }
+            else if (rep_colonne[j] == j) { indices[mr] = j; r->colonne_reduite[j] = mr++; }
+            else r->colonne_reduite[j] = r->colonne_reduite[rep_colonne[j]];
+        }
+        r->bilan.cases_fixees = r->nb_fixees;
+        r->bilan.n_reduit = nr;
+        r->bilan.m_reduit = mr;
+        r->bilan.reduit = (nr < n || mr < m);
+        // Tout acheminé par les affectations forcées : pas de problème réduit
+        if (r->bilan.reduit && nr > 0 && mr > 0) ok = construireReduit(r, p, eligibles, indices);
+    }
+
+    free(rep_ligne); free(rep_colonne); free(eligibles); free(indices);
+    free(e.debut_col); free(e.ligne_col); free(e.capacite_col);
+    if (!ok) { libererReduction(r); return NULL; }
+    return r;
+}
+
+// ==========================================================
+// 4. RECONSTRUCTION DE LA SOLUTION (POSTSOLVE)
+// ==========================================================
+
+/**
+ * @brief Membres de chaque groupe, par indice croissant (CSR) : debut[g]..debut[g+1]-1 dans membres.
+ */
+static bool listerMembres(const int* groupe, int nb, int nb_groupes, int** debut, int** membres) {
+    *debut = (int*)calloc(nb_groupes + 1, sizeof(int));
+    *membres = (int*)malloc((nb + 1) * sizeof(int));
+    if (!*debut || !*membres) return false;
+    for (int x = 0; x < nb; x++) if (groupe[x] >= 0) (*debut)[groupe[x] + 1]++;
+    for (int g = 0; g < nb_groupes; g++) (*debut)[g + 1] += (*debut)[g];
+    int* remplis = (int*)calloc(nb_groupes + 1, sizeof(int));
+    if (!remplis) return false;
+    for (int x = 0; x < nb; x++) if (groupe[x] >= 0) (*membres)[(*debut)[groupe[x]] + remplis[groupe[x]]++] = x;
+    free(remplis);
+    return true;
+}
+
+bool restaurerSolution(const ReductionProbleme* r, ProblemeTransport* p) {
+    if (!r || p->n != r->n || p->m != r->m) return false;
+    reinitialiserSolution(p);
+    for (int k = 0; k < r->nb_fixees; k++) p->B[r->fixees[k].i][r->fixees[k].j] += r->fixees[k].quantite;
+    const ProblemeTransport* q = r->reduit;
+    if (!q) return true;
+    int nr = q->n, mr = q->m;
+
+    long nb_flux = 0;
+    for (int g = 0; g < nr; g++)
+        for (int h = 0; h < mr; h++) nb_flux += (q->B[g][h] > 0);
+    int *debut_l = NULL, *membres_l = NULL, *debut_c = NULL, *membres_c = NULL;
+    // Étape 1 : (g, j, quantité) ; le coin nord-ouest d'un groupe ajoute au plus un flux par membre
+    CaseBase* flux = (CaseBase*)malloc((nb_flux + r->m + 1) * sizeof(CaseBase));
+    int* debut_g = (int*)calloc(nr + 1, sizeof(int));
+    CaseBase* tri = (CaseBase*)malloc((nb_flux + r->m + 1) * sizeof(CaseBase));
+    bool ok = flux && debut_g && tri && listerMembres(r->ligne_reduite, r->n, nr, &debut_l, &membres_l)
+           && listerMembres(r->colonne_reduite, r->m, mr, &debut_c, &membres_c);
+
+    // Colonnes fusionnées : coûts identiques, toute répartition respectant les demandes convient.
+    // Le coin nord-ouest garde un arbre : la passe finale part d'une base sans cycle.
+    int nb = 0;
+    for (int h = 0; ok && h < mr; h++) {
+        int t = debut_c[h], reste_membre = r->demande_residuelle[membres_c[t]];
+        for (int g = 0; g < nr; g++) {
+            int x = q->B[g][h];
+            while (x > 0 && t < debut_c[h + 1]) {
+                int d = (x < reste_membre) ? x : reste_membre;
+                if (d > 0) { flux[nb].i = g; flux[nb].j = membres_c[t]; flux[nb++].quantite = d; }
+                x -= d;
+                reste_membre -= d;
+                if (reste_membre == 0 && ++t < debut_c[h + 1]) reste_membre = r->demande_residuelle[membres_c[t]];
+            }
+            ok = ok && x == 0;
+        }
+    }
+
+    // Étape 2 : flux regroupés par ligne réduite, puis ventilés de même sur les fournisseurs du groupe
+    if (ok) {
+        for (int k = 0; k < nb; k++) debut_g[flux[k].i + 1]++;
+        for (int g = 0; g < nr; g++) debut_g[g + 1] += debut_g[g];
+        for (int k = 0; k < nb; k++) tri[debut_g[flux[k].i]++] = flux[k];
+        for (int g = nr; g > 0; g--) debut_g[g] = debut_g[g - 1];
+        debut_g[0] = 0;
+    }
+    for (int g = 0; ok && g < nr; g++) {
+        int t = debut_l[g], reste_membre = r->offre_residuelle[membres_l[t]];
+        for (int k = debut_g[g]; k < debut_g[g + 1]; k++) {
+            int x = tri[k].quantite, j = tri[k].j;
+            while (x > 0 && t < debut_l[g + 1]) {
+                int d = (x < reste_membre) ? x : reste_membre;
+                p->B[membres_l[t]][j] += d;
+                x -= d;
+                reste_membre -= d;
+                if (reste_membre == 0 && ++t < debut_l[g + 1]) reste_membre = r->offre_residuelle[membres_l[t]];
+            }
+            ok = ok && x == 0;
+        }
+    }
+
+    free(flux); free(debut_g); free(tri);
+    free(debut_l); free(membres_l); free(debut_c); free(membres_c);
+    return ok;
+}
+
+// ==========================================================
+// 5. RESOLUTION AVEC REDUCTION
+// ==========================================================
+
+SolutionCreuse* resoudreReduit(ProblemeTransport* p, MethodeInitiale methode, const OptionsMarchePied* options,
+                               ResultatReduction* bilan) {
+    OptionsMarchePied finale;
+    if (options) finale = *options;
+    else optionsMarchePiedParDefaut(&finale);
+    ResultatReduction local;
+    if (!bilan) bilan = &local;
+    memset(bilan, 0, sizeof(*bilan));
+    bilan->n_reduit = p->n;
+    bilan->m_reduit = p->m;
+
+    double debut = horlogeMurale();
+    ReductionProbleme* r = reduireProbleme(p);
+    bool ok = r && r->bilan.reduit;
+    if (ok) {
+        *bilan = r->bilan;
+        if (r->reduit) {
+            OptionsMarchePied o = finale;
+            o.trace = NULL;
+            o.resultat = NULL;
+            ResultatMarchePied stats;
+            memset(&stats, 0, sizeof(stats));
+            SolutionCreuse* sol = resoudreAnytime(r->reduit, methode, &o, &stats);
+            // Réduit irréalisable (capacités) : la résolution directe le signalera sur le problème complet
+            ok = sol && solutionAdmissible(r->reduit);
+            libererSolutionCreuse(sol);
+            bilan->pivots_reduit = stats.pivots;
+        }
+        ok = ok && restaurerSolution(r, p);
+        bilan->duree_reduit = horlogeMurale() - debut;
+    }
+    bilan->reduit = ok;
+    libererReduction(r);
+
+    if (!ok) return resoudreAnytime(p, methode, &finale, finale.resultat);
+    // Passe finale sur le problème complet : base, potentiels et certificat à partir de B reconstruite
+    if (finale.delai_max > 0.0) {
+        double restant = finale.delai_max - bilan->duree_reduit;
+        finale.delai_max = (restant > 1e-9) ? restant : 1e-9;
+    }
+    return algoMarchePiedOptions(p, &finale);
+}
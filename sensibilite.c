@@ -0,0 +1,224 @@
+/**
+ * @file sensibilite.c
+ * @brief Analyse de sensibilité (plages de coûts et de second membre) sur la base optimale.
+ * Tout est déduit de l'arbre de la base et des potentiels : aucune nouvelle résolution.
+ */
+
+#include "projet_ro.h"
+
+// ==========================================================
+// 1. ARBRE DE LA BASE
+// ==========================================================
+
+/**
+ * @brief Enracine l'arbre de la base en F0 (parcours BFS) : parent, profondeur et quantité de l'arête vers le parent.
+ * @return false si les cases ne forment pas un arbre couvrant (n+m-1 cases, connexe).
+ */
+static bool construireArbreBase(AnalyseSensibilite* a, const SolutionCreuse* sol) {
+    int n = a->n, m = a->m, nb_noeuds = n + m;
+    if (sol->nb_cases != nb_noeuds - 1) return false;
+
+    // Listes d'adjacence compactes : debut[u]..debut[u+1]-1 dans voisins / cases
+    int* debut = (int*)calloc(nb_noeuds + 1, sizeof(int));
+    int* voisins = (int*)malloc(2 * sol->nb_cases * sizeof(int));
+    int* cases = (int*)malloc(2 * sol->nb_cases * sizeof(int));
+    int* remplis = (int*)calloc(nb_noeuds, sizeof(int));
+    bool ok = debut && voisins && cases && remplis;
+
+    for (int k = 0; ok && k < sol->nb_cases; k++) {
+        debut[sol->cases[k].i + 1]++;
+        debut[n + sol->cases[k].j + 1]++;
+    }
+    for (int u = 0; ok && u < nb_noeuds; u++) debut[u + 1] += debut[u];
+    for (int k = 0; ok && k < sol->nb_cases; k++) {
+        int u = sol->cases[k].i, v = n + sol->cases[k].j;
+        voisins[debut[u] + remplis[u]] = v; cases[debut[u] + remplis[u]++] = k;
+        voisins[debut[v] + remplis[v]] = u; cases[debut[v] + remplis[v]++] = k;
+    }
+
+    int atteints = 0;
+    if (ok) {
+        for (int u = 0; u < nb_noeuds; u++) a->parent[u] = -2; // -2 : non atteint
+        Queue* q = creerQueue(nb_noeuds);
+        if (!q) { free(debut); free(voisins); free(cases); free(remplis); return false; }
+        a->parent[0] = -1;
+        a->profondeur[0] = 0;
+        a->flux_parent[0] = 0;
+        enqueue(q, 0, -1);
+        atteints = 1;
+        while (!isQueueEmpty(q)) {
+            int u = dequeue(q).index;
+            for (int e = debut[u]; e < debut[u + 1]; e++) {
+                int v = voisins[e];
+                if (a->parent[v] != -2) continue;
+                a->parent[v] = u;
+                a->profondeur[v] = a->profondeur[u] + 1;
+                a->flux_parent[v] = sol->cases[cases[e]].quantite;
+                enqueue(q, v, u);
+                atteints++;
+            }
+        }
+        libererQueue(q);
+    }
+
+    free(debut); free(voisins); free(cases); free(remplis);
+    return ok && atteints == nb_noeuds;
+}
+
+/**
+ * @brief Case (i, j) de l'arête qui relie le noeud x à son parent.
+ */
+static void caseArete(const AnalyseSensibilite* a, int x, int* i, int* j) {
+    int y = a->parent[x];
+    if (x < a->n) { *i = x; *j = y - a->n; }
+    else { *i = y; *j = x - a->n; }
+}
+
+// ==========================================================
+// 2. PLAGES DE COUTS
+// ==========================================================
+
+void libererAnalyseSensibilite(AnalyseSensibilite* a) {
+    if (!a) return;
+    free(a->cout_min); free(a->cout_max);
+    free(a->parent); free(a->profondeur); free(a->flux_parent);
+    free(a->E_s); free(a->E_t);
+    free(a);
+}
+
+AnalyseSensibilite* analyserSensibilite(const ProblemeTransport* p, const SolutionCreuse* sol) {
+    if (!p || !sol || !sol->E_s || !sol->E_t || sol->n != p->n || sol->m != p->m) return NULL;
+    int n = p->n, m = p->m;
+
+    AnalyseSensibilite* a = (AnalyseSensibilite*)calloc(1, sizeof(AnalyseSensibilite));
+    if (!a) return NULL;
+    a->n = n; a->m = m;
+    a->cout_min = (double*)malloc((size_t)n * m * sizeof(double));
+    a->cout_max = (double*)malloc((size_t)n * m * sizeof(double));
+    a->parent = (int*)malloc((n + m) * sizeof(int));
+    a->profondeur = (int*)malloc((n + m) * sizeof(int));
+    a->flux_parent = (int*)malloc((n + m) * sizeof(int));
+    a->E_s = (double*)malloc(n * sizeof(double));
+    a->E_t = (double*)malloc(m * sizeof(double));
+    if (!a->cout_min || !a->cout_max || !a->parent || !a->profondeur || !a->flux_parent || !a->E_s || !a->E_t
+        || !construireArbreBase(a, sol)) {
+        libererAnalyseSensibilite(a);
+        return NULL;
+    }
+    memcpy(a->E_s, sol->E_s, n * sizeof(double));
+    memcpy(a->E_t, sol->E_t, m * sizeof(double));
+
+    // Marge de hausse / baisse des cases de base, indexée par le noeud fils de l'arête
+    double* hausse = (double*)malloc((n + m) * sizeof(double));
+    double* baisse = (double*)malloc((n + m) * sizeof(double));
+    char* de_base = (char*)calloc((size_t)n * m, 1);
+    if (!hausse || !baisse || !de_base) {
+        free(hausse); free(baisse); free(de_base);
+        libererAnalyseSensibilite(a);
+        return NULL;
+    }
+    for (int u = 0; u < n + m; u++) { hausse[u] = DBL_MAX; baisse[u] = DBL_MAX; }
+    for (int k = 0; k < sol->nb_cases; k++) de_base[(long)sol->cases[k].i * m + sol->cases[k].j] = 1;
+
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < m; j++) {
+            long c = (long)i * m + j;
+            if (de_base[c]) continue;
+            double delta = p->A[i][j] - (a->E_s[i] - a->E_t[j]);
+            if (delta < 0.0) delta = 0.0;
+            a->cout_min[c] = p->A[i][j] - delta;
+            a->cout_max[c] = DBL_MAX;
+
+            // Chemin F_i -> C_j dans l'arbre : chaque arête du chemin est traversée par la case (i, j).
+            // Si A[k][l] augmente de d, les potentiels du côté de F_k se décalent de d : le coût marginal
+            // de (i, j) baisse de d si F_i est du côté de F_k, augmente de d sinon.
+            int x = i, y = n + j;
+            while (x != y) {
+                bool cote_i = a->profondeur[x] >= a->profondeur[y];
+                int fils = cote_i ? x : y;
+                // F_i est du côté de F_k si (F_i dans le sous-arbre du fils) == (le fils est la ligne k)
+                bool meme_cote = (cote_i == (fils < n));
+                double* marge = meme_cote ? &hausse[fils] : &baisse[fils];
+                if (delta < *marge) *marge = delta;
+                if (cote_i) x = a->parent[x]; else y = a->parent[y];
+            }
+        }
+    }
+
+    for (int u = 1; u < n + m; u++) {
+        int i, j;
+        caseArete(a, u, &i, &j);
+        long c = (long)i * m + j;
+        a->cout_max[c] = (hausse[u] == DBL_MAX) ? DBL_MAX : p->A[i][j] + hausse[u];
+        a->cout_min[c] = (baisse[u] == DBL_MAX) ? -DBL_MAX : p->A[i][j] - baisse[u];
+    }
+
+    free(hausse); free(baisse); free(de_base);
+    return a;
+}
+
+// ==========================================================
+// 3. PLAGES DU SECOND MEMBRE
+// ==========================================================
+
+double plageSecondMembre(const AnalyseSensibilite* a, int i, int j, int* delta_min, int* delta_max) {
+    int n = a->n;
+    *delta_min = INT_MIN;
+    *delta_max = INT_MAX;
+
+    // Les delta unités vont de F_i à C_j : +delta sur les arêtes parcourues ligne -> colonne, -delta sinon
+    int x = i, y = n + j;
+    while (x != y) {
+        bool cote_i = a->profondeur[x] >= a->profondeur[y];
+        int fils = cote_i ? x : y;
+        // Côté F_i on monte (fils -> parent), côté C_j on descend (parent -> fils)
+        bool ligne_vers_colonne = (cote_i == (fils < n));
+        int flux = a->flux_parent[fils];
+        if (ligne_vers_colonne) { if (-flux > *delta_min) *delta_min = -flux; }
+        else { if (flux < *delta_max) *delta_max = flux; }
+        if (cote_i) x = a->parent[x]; else y = a->parent[y];
+    }
+    return a->E_s[i] - a->E_t[j];
+}
+
+// ==========================================================
+// 4. AFFICHAGE
+// ==========================================================
+
+static void afficherBorne(double v) {
+    if (v == DBL_MAX) printf("%10s", "+inf");
+    else if (v == -DBL_MAX) printf("%10s", "-inf");
+    else printf("%10.2f", v);
+}
+
+void afficherAnalyseSensibilite(const ProblemeTransport* p, const SolutionCreuse* sol, const AnalyseSensibilite* a) {
+    printf("\n--- PLAGES DES COUTS (cases de base) ---\n");
+    printf("  Case        Cout       Min       Max\n");
+    for (int k = 0; k < sol->nb_cases; k++) {
+        int i = sol->cases[k].i, j = sol->cases[k].j;
+        long c = (long)i * a->m + j;
+        printf("  (F%d, C%d) %8.2f  ", i, j, p->A[i][j]);
+        afficherBorne(a->cout_min[c]);
+        afficherBorne(a->cout_max[c]);
+        printf("\n");
+    }
+
+    if ((long)a->n * a->m > 100) return;
+    printf("\n--- COUTS MINIMAUX DES CASES HORS BASE (au-dessous, la base change) ---\n       ");
+    for (int j = 0; j < a->m; j++) {
+        char entete[16];
+        snprintf(entete, sizeof(entete), "C%d", j);
+        printf("%8s ", entete);
+    }
+    printf("\n");
+    for (int i = 0; i < a->n; i++) {
+        printf(" F%-4d ", i);
+        for (int j = 0; j < a->m; j++) {
+            // Case de base : arête de l'arbre entre F_i et C_j
+            bool de_base = a->parent[i] == a->n + j || a->parent[a->n + j] == i;
+            if (de_base) printf("%8s ", "base");
+            else printf("%8.2f ", a->cout_min[(long)i * a->m + j]);
+        }
+        printf("\n");
+    }
+}
@@ -0,0 +1,198 @@
+/**
+ * @file solveur.c
+ * @brief Bibliothèque réentrante : poignée de solveur possédant son problème, sa solution et son pool.
+ * Aucune écriture sur stdout, aucun exit() : chaque erreur est signalée par un CodeRetour.
+ * Les ressources d'une poignée ne sont partagées avec aucune autre : des poignées distinctes
+ * se résolvent en parallèle depuis des threads différents sans synchronisation.
+ */
+
+#include "projet_ro.h"
+#include <math.h>
+
+struct SolveurTransport {
+    ProblemeTransport* p;
+    SolutionCreuse* solution;  // Dernière solution (NULL : aucune)
+    ResultatMarchePied stats;  // Statistiques de la dernière résolution
+    PoolThreads* pool;         // Créé à la première résolution parallèle, réutilisé ensuite
+    int nb_threads_pool;       // Nombre de threads demandés à la création du pool
+};
+
+// ==========================================================
+// 1. CREATION ET DONNEES
+// ==========================================================
+
+void optionsSolveurParDefaut(OptionsSolveur* o) {
+    OptionsMarchePied defaut;
+    optionsMarchePiedParDefaut(&defaut);
+    o->methode = METHODE_BALAS_HAMMER;
+    o->reprendre_base = false;
+    o->max_iterations = defaut.max_iterations;
+    o->delai_max = 0.0;
+    o->nb_threads = 1;
+    o->pool = NULL;
+    o->cache = NULL;
+    o->annulation = NULL;
+}
+
+/**
+ * @brief Copie une matrice de coûts ligne par ligne dans A (valeurs finies exigées).
+ */
+static bool copierCouts(ProblemeTransport* p, const double* couts) {
+    for (long k = 0; k < (long)p->n * p->m; k++)
+        if (!isfinite(couts[k])) return false;
+    for (int i = 0; i < p->n; i++)
+        memcpy(p->A[i], couts + (long)i * p->m, p->m * sizeof(double));
+    return true;
+}
+
+CodeRetour creerSolveur(int n, int m, const double* couts, const int* offres, const int* demandes,
+                        SolveurTransport** sortie) {
+    if (!sortie) return RETOUR_ARGUMENT_INVALIDE;
+    *sortie = NULL;
+    if (n <= 0 || m <= 0 || !couts || !offres || !demandes) return RETOUR_ARGUMENT_INVALIDE;
+
+    long total_offre = 0, total_demande = 0;
+    for (int i = 0; i < n; i++) {
+        if (offres[i] < 0) return RETOUR_ARGUMENT_INVALIDE;
+        total_offre += offres[i];
+    }
+    for (int j = 0; j < m; j++) {
+        if (demandes[j] < 0) return RETOUR_ARGUMENT_INVALIDE;
+        total_demande += demandes[j];
+    }
+    if (total_offre != total_demande) return RETOUR_DESEQUILIBRE;
+
+    SolveurTransport* s = (SolveurTransport*)calloc(1, sizeof(SolveurTransport));
+    if (!s) return RETOUR_MEMOIRE;
+    s->p = creerProbleme(n, m);
+    if (!s->p) { free(s); return RETOUR_MEMOIRE; }
+    if (!copierCouts(s->p, couts)) { libererSolveur(s); return RETOUR_ARGUMENT_INVALIDE; }
+    memcpy(s->p->P, offres, n * sizeof(int));
+    memcpy(s->p->C, demandes, m * sizeof(int));
+    if (!actualiserCouts(s->p)) { libererSolveur(s); return RETOUR_MEMOIRE; }
+    s->stats.cause = ARRET_OPTIMAL;
+
+    *sortie = s;
+    return RETOUR_OK;
+}
+
+void libererSolveur(SolveurTransport* s) {
+    if (!s) return;
+    libererSolutionCreuse(s->solution);
+    libererPoolThreads(s->pool);
+    libererProbleme(s->p);
+    free(s);
+}
+
+CodeRetour definirCapacitesSolveur(SolveurTransport* s, int nb, const int* lignes, const int* colonnes,
+                                   const int* capacites) {
+    if (!s || nb < 0 || (nb > 0 && (!lignes || !colonnes || !capacites))) return RETOUR_ARGUMENT_INVALIDE;
+    for (int t = 0; t < nb; t++)
+        if (lignes[t] < 0 || lignes[t] >= s->p->n || colonnes[t] < 0 || colonnes[t] >= s->p->m
+            || capacites[t] < 0)
+            return RETOUR_ARGUMENT_INVALIDE;
+    // Les arguments étant valides, un échec ne peut venir que d'une allocation
+    return definirCapacites(s->p, nb, lignes, colonnes, capacites) ? RETOUR_OK : RETOUR_MEMOIRE;
+}
+
+CodeRetour modifierCoutsSolveur(SolveurTransport* s, const double* couts) {
+    if (!s || !couts) return RETOUR_ARGUMENT_INVALIDE;
+    if (!copierCouts(s->p, couts)) return RETOUR_ARGUMENT_INVALIDE;
+    return actualiserCouts(s->p) ? RETOUR_OK : RETOUR_MEMOIRE;
+}
+
+CodeRetour modifierCasesSolveur(SolveurTransport* s, int nb, const int* lignes, const int* colonnes,
+                                const double* couts) {
+    if (!s || nb < 0 || (nb > 0 && (!lignes || !colonnes || !couts))) return RETOUR_ARGUMENT_INVALIDE;
+    ProblemeTransport* p = s->p;
+    for (int k = 0; k < nb; k++)
+        if (lignes[k] < 0 || lignes[k] >= p->n || colonnes[k] < 0 || colonnes[k] >= p->m || !isfinite(couts[k]))
+            return RETOUR_ARGUMENT_INVALIDE;
+    if (nb == 0) return RETOUR_OK;
+    for (int k = 0; k < nb; k++) {
+        p->A[lignes[k]][colonnes[k]] = couts[k];
+        p->At[(long)colonnes[k] * p->n + lignes[k]] = couts[k];
+    }
+    invaliderOrdresCouts(p);
+    return RETOUR_OK;
+}
+
+// ==========================================================
+// 2. RESOLUTION
+// ==========================================================
+
+/**
+ * @brief Pool de la poignée pour nb_threads (NULL : séquentiel). Recréé seulement si le nombre change.
+ */
+static PoolThreads* poolSolveur(SolveurTransport* s, int nb_threads) {
+    if (nb_threads == 1) return NULL;
+    if (s->pool && s->nb_threads_pool == nb_threads) return s->pool;
+    libererPoolThreads(s->pool);
+    s->pool = creerPoolThreads(nb_threads);
+    s->nb_threads_pool = nb_threads;
+    return s->pool; // NULL si l'allocation échoue : la résolution reste séquentielle
+}
+
+CodeRetour resoudreSolveur(SolveurTransport* s, const OptionsSolveur* o) {
+    if (!s) return RETOUR_ARGUMENT_INVALIDE;
+    OptionsSolveur opt;
+    if (o) opt = *o;
+    else optionsSolveurParDefaut(&opt);
+    if (opt.max_iterations < 0 || opt.methode < METHODE_NORD_OUEST || opt.methode > METHODE_MOINDRE_COUT)
+        return RETOUR_ARGUMENT_INVALIDE;
+
+    ProblemeTransport* p = s->p;
+    OptionsMarchePied options;
+    optionsMarchePiedParDefaut(&options);
+    options.max_iterations = opt.max_iterations;
+    options.delai_max = opt.delai_max;
+    options.annulation = opt.annulation;
+    options.pool = opt.pool ? opt.pool : poolSolveur(s, opt.nb_threads);
+    options.resultat = &s->stats;
+
+    // Reprise à chaud : la base précédente reste admissible tant que offres et demandes sont inchangées
+    SolutionCreuse* precedente = s->solution;
+    s->solution = NULL;
+    SolutionCreuse* sol;
+    if (opt.cache)
+        sol = resoudreAvecCache(p, opt.cache, opt.methode, opt.reprendre_base ? precedente : NULL, &options, NULL);
+    else if (opt.reprendre_base && precedente && appliquerBaseVoisine(p, precedente))
+        sol = algoMarchePiedOptions(p, &options);
+    else
+        sol = resoudreAnytime(p, opt.methode, &options, &s->stats);
+    libererSolutionCreuse(precedente);
+
+    if (!sol) return RETOUR_MEMOIRE;
+    if (!solutionAdmissible(p)) {
+        libererSolutionCreuse(sol);
+        // Sans capacités, la solution initiale est toujours admissible : l'échec vient d'une allocation
+        return p->U ? RETOUR_IRREALISABLE : RETOUR_MEMOIRE;
+    }
+    s->solution = sol;
+    return s->stats.optimal ? RETOUR_OK : RETOUR_ARRET_ANTICIPE;
+}
+
+// ==========================================================
+// 3. RESULTATS
+// ==========================================================
+
+const SolutionCreuse* solutionSolveur(const SolveurTransport* s) {
+    return s ? s->solution : NULL;
+}
+
+const ResultatMarchePied* resultatSolveur(const SolveurTransport* s) {
+    return s ? &s->stats : NULL;
+}
+
+const char* messageRetour(CodeRetour code) {
+    switch (code) {
+        case RETOUR_OK: return "ok";
+        case RETOUR_ARRET_ANTICIPE: return "arret anticipe";
+        case RETOUR_ARGUMENT_INVALIDE: return "argument invalide";
+        case RETOUR_DESEQUILIBRE: return "desequilibre";
+        case RETOUR_IRREALISABLE: return "irrealisable";
+        case RETOUR_MEMOIRE: return "memoire";
+        case RETOUR_COMMUNICATION: return "communication";
+    }
+    return "inconnu";
+}
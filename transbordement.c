@@ -0,0 +1,430 @@
+/**
+ * @file transbordement.c
+ * @brief Problème de transbordement sur un réseau général (entrepôts de transit, arcs entre toute paire
+ * de noeuds). Simplexe des réseaux : potentiels de l'arbre de base et pivot le long du cycle, comme le
+ * Marche-Pied, mais sur des listes d'arcs creuses (aucune matrice dense n x m n'est construite).
+ */
+
+#include "projet_ro.h"
+#include <math.h>
+
+#define EPSILON 1e-9
+
+// État d'un arc : hors base à 0 (ARC_INF) ou à sa capacité (ARC_SUP). Le signe donne le sens
+// d'amélioration : l'arc est candidat si etat * coût marginal < 0.
+#define ARC_BASE 0
+#define ARC_INF 1
+#define ARC_SUP (-1)
+
+// ==========================================================
+// 1. CONSTRUCTION DU RESEAU
+// ==========================================================
+
+ReseauTransbordement* creerReseau(int nb_noeuds, int capacite_arcs) {
+    if (nb_noeuds <= 0) return NULL;
+    if (capacite_arcs < 1) capacite_arcs = 1;
+    ReseauTransbordement* r = (ReseauTransbordement*)calloc(1, sizeof(ReseauTransbordement));
+    if (!r) return NULL;
+    r->nb_noeuds = nb_noeuds;
+    r->capacite_arcs = capacite_arcs;
+    r->offre = (int*)calloc(nb_noeuds, sizeof(int));
+    r->potentiel = (double*)calloc(nb_noeuds, sizeof(double));
+    r->origine = (int*)malloc(capacite_arcs * sizeof(int));
+    r->destination = (int*)malloc(capacite_arcs * sizeof(int));
+    r->cout = (double*)malloc(capacite_arcs * sizeof(double));
+    r->capacite = (int*)malloc(capacite_arcs * sizeof(int));
+    r->flux = (int*)malloc(capacite_arcs * sizeof(int));
+    if (!r->offre || !r->potentiel || !r->origine || !r->destination || !r->cout || !r->capacite || !r->flux) {
+        libererReseau(r);
+        return NULL;
+    }
+    return r;
+}
+
+void libererReseau(ReseauTransbordement* r) {
+    if (!r) return;
+    free(r->offre); free(r->potentiel);
+    free(r->origine); free(r->destination); free(r->cout); free(r->capacite); free(r->flux);
+    free(r);
+}
+
+/**
+ * @brief Double la taille des tableaux d'arcs.
+ */
+static bool agrandirArcs(ReseauTransbordement* r) {
+    int taille = 2 * r->capacite_arcs;
+    int* origine = (int*)realloc(r->origine, taille * sizeof(int));
+    if (origine) r->origine = origine;
+    int* destination = (int*)realloc(r->destination, taille * sizeof(int));
+    if (destination) r->destination = destination;
+    double* cout = (double*)realloc(r->cout, taille * sizeof(double));
+    if (cout) r->cout = cout;
+    int* capacite = (int*)realloc(r->capacite, taille * sizeof(int));
+    if (capacite) r->capacite = capacite;
+    int* flux = (int*)realloc(r->flux, taille * sizeof(int));
+    if (flux) r->flux = flux;
+    if (!origine || !destination || !cout || !capacite || !flux) return false;
+    r->capacite_arcs = taille;
+    return true;
+}
+
+bool ajouterArc(ReseauTransbordement* r, int u, int v, double cout, int capacite) {
+    if (u < 0 || u >= r->nb_noeuds || v < 0 || v >= r->nb_noeuds || u == v || capacite < 0) return false;
+    if (r->nb_arcs == r->capacite_arcs && !agrandirArcs(r)) return false;
+    int a = r->nb_arcs++;
+    r->origine[a] = u;
+    r->destination[a] = v;
+    r->cout[a] = cout;
+    r->capacite[a] = capacite;
+    r->flux[a] = 0;
+    return true;
+}
+
+ReseauTransbordement* lireReseau(const char* nomFichier) {
+    FILE* f = fopen(nomFichier, "r");
+    if (!f) { perror("Erreur ouverture fichier"); return NULL; }
+    int nb_noeuds, nb_arcs;
+    ReseauTransbordement* r = NULL;
+    if (fscanf(f, "%d %d", &nb_noeuds, &nb_arcs) == 2 && nb_arcs >= 0)
+        r = creerReseau(nb_noeuds, nb_arcs);
+    bool ok = r != NULL;
+    for (int v = 0; ok && v < nb_noeuds; v++) ok = fscanf(f, "%d", &r->offre[v]) == 1;
+    for (int a = 0; ok && a < nb_arcs; a++) {
+        int u, v, capacite;
+        double cout;
+        ok = fscanf(f, "%d %d %lf %d", &u, &v, &cout, &capacite) == 4
+             && ajouterArc(r, u, v, cout, (capacite < 0) ? INT_MAX : capacite);
+    }
+    fclose(f);
+    if (!ok) {
+        fprintf(stderr, "Reseau invalide dans '%s'\n", nomFichier);
+        libererReseau(r);
+        return NULL;
+    }
+    return r;
+}
+
+ReseauTransbordement* reseauDepuisProbleme(const ProblemeTransport* p) {
+    ReseauTransbordement* r = creerReseau(p->n + p->m, p->n * p->m);
+    if (!r) return NULL;
+    for (int i = 0; i < p->n; i++) r->offre[i] = p->P[i];
+    for (int j = 0; j < p->m; j++) r->offre[p->n + j] = -p->C[j];
+    for (int i = 0; i < p->n; i++)
+        for (int j = 0; j < p->m; j++)
+            ajouterArc(r, i, p->n + j, p->A[i][j], capaciteCase(p, i, j));
+    return r;
+}
+
+double coutReseau(const ReseauTransbordement* r) {
+    double total = 0.0;
+    for (int a = 0; a < r->nb_arcs; a++) total += r->flux[a] * r->cout[a];
+    return total;
+}
+
+void afficherFluxReseau(const ReseauTransbordement* r) {
+    int affiches = 0, non_nuls = 0;
+    printf("\n--- FLUX DU RESEAU (%d noeuds, %d arcs) ---\n", r->nb_noeuds, r->nb_arcs);
+    for (int a = 0; a < r->nb_arcs; a++) {
+        if (r->flux[a] == 0) continue;
+        non_nuls++;
+        if (affiches == 100) continue;
+        printf("  %d -> %d : %d (cout %.2f)\n", r->origine[a], r->destination[a], r->flux[a], r->cout[a]);
+        affiches++;
+    }
+    if (non_nuls > affiches) printf("  ... %d arcs non affiches\n", non_nuls - affiches);
+    printf("Cout total : %.2f (%d arcs de flux non nul)\n", coutReseau(r), non_nuls);
+}
+
+// ==========================================================
+// 2. ARBRE COUVRANT
+// ==========================================================
+
+/**
+ * @brief Arbre de base du simplexe des réseaux. Les arcs du réseau sont suivis de nb_noeuds arcs
+ * artificiels (un par noeud, vers ou depuis la racine artificielle d'indice nb_noeuds).
+ * Les fils d'un noeud forment une liste doublement chaînée pour détacher un sous-arbre en O(1).
+ */
+typedef struct {
+    int nb_noeuds;      // Noeuds du réseau + racine artificielle
+    int nb_arcs;        // Arcs du réseau + arcs artificiels
+    int* origine;
+    int* destination;
+    double* cout;
+    int* capacite;
+    int* flux;
+    signed char* etat;  // ARC_BASE, ARC_INF ou ARC_SUP
+    int* parent;        // Parent du noeud (-1 pour la racine)
+    int* arc_parent;    // Arc reliant le noeud à son parent
+    int* profondeur;
+    int* premier_fils;
+    int* frere_suivant;
+    int* frere_precedent;
+    int* pile;          // Parcours en profondeur d'un sous-arbre
+    double* E;          // Potentiels : E[origine] - E[destination] = coût sur les arcs de base
+} ArbreReseau;
+
+static void libererArbreReseau(ArbreReseau* t) {
+    free(t->origine); free(t->destination); free(t->cout); free(t->capacite); free(t->flux); free(t->etat);
+    free(t->parent); free(t->arc_parent); free(t->profondeur);
+    free(t->premier_fils); free(t->frere_suivant); free(t->frere_precedent); free(t->pile); free(t->E);
+}
+
+static void detacherNoeud(ArbreReseau* t, int x) {
+    int precedent = t->frere_precedent[x], suivant = t->frere_suivant[x];
+    if (precedent >= 0) t->frere_suivant[precedent] = suivant;
+    else t->premier_fils[t->parent[x]] = suivant;
+    if (suivant >= 0) t->frere_precedent[suivant] = precedent;
+}
+
+static void attacherNoeud(ArbreReseau* t, int x, int parent, int arc) {
+    t->parent[x] = parent;
+    t->arc_parent[x] = arc;
+    t->frere_precedent[x] = -1;
+    t->frere_suivant[x] = t->premier_fils[parent];
+    if (t->premier_fils[parent] >= 0) t->frere_precedent[t->premier_fils[parent]] = x;
+    t->premier_fils[parent] = x;
+}
+
+/**
+ * @brief Base initiale : étoile sur la racine artificielle. Un noeud d'offre envoie son offre à la racine,
+ * les autres la reçoivent (flux nul pour le transit). Coût artificiel M > toute chaîne d'arcs réels : les
+ * arcs artificiels sortent de la base dès que le réseau le permet. Les arcs de flux nul partent de la
+ * racine : l'arbre initial est fortement admissible.
+ */
+static bool construireArbreInitial(ArbreReseau* t, const ReseauTransbordement* r) {
+    int n = r->nb_noeuds, racine = n;
+    t->nb_noeuds = n + 1;
+    t->nb_arcs = r->nb_arcs + n;
+    t->origine = (int*)malloc(t->nb_arcs * sizeof(int));
+    t->destination = (int*)malloc(t->nb_arcs * sizeof(int));
+    t->cout = (double*)malloc(t->nb_arcs * sizeof(double));
+    t->capacite = (int*)malloc(t->nb_arcs * sizeof(int));
+    t->flux = (int*)malloc(t->nb_arcs * sizeof(int));
+    t->etat = (signed char*)malloc(t->nb_arcs * sizeof(signed char));
+    t->parent = (int*)malloc(t->nb_noeuds * sizeof(int));
+    t->arc_parent = (int*)malloc(t->nb_noeuds * sizeof(int));
+    t->profondeur = (int*)malloc(t->nb_noeuds * sizeof(int));
+    t->premier_fils = (int*)malloc(t->nb_noeuds * sizeof(int));
+    t->frere_suivant = (int*)malloc(t->nb_noeuds * sizeof(int));
+    t->frere_precedent = (int*)malloc(t->nb_noeuds * sizeof(int));
+    t->pile = (int*)malloc(t->nb_noeuds * sizeof(int));
+    t->E = (double*)malloc(t->nb_noeuds * sizeof(double));
+    if (!t->origine || !t->destination || !t->cout || !t->capacite || !t->flux || !t->etat || !t->parent
+        || !t->arc_parent || !t->profondeur || !t->premier_fils || !t->frere_suivant || !t->frere_precedent
+        || !t->pile || !t->E) return false;
+
+    double cout_max = 0.0;
+    for (int a = 0; a < r->nb_arcs; a++) {
+        t->origine[a] = r->origine[a];
+        t->destination[a] = r->destination[a];
+        t->cout[a] = r->cout[a];
+        t->capacite[a] = r->capacite[a];
+        t->flux[a] = 0;
+        t->etat[a] = ARC_INF;
+        if (fabs(r->cout[a]) > cout_max) cout_max = fabs(r->cout[a]);
+    }
+    double M = 1.0 + (double)n * cout_max;
+
+    for (int v = 0; v <= racine; v++) t->premier_fils[v] = -1;
+    t->parent[racine] = -1;
+    t->arc_parent[racine] = -1;
+    t->profondeur[racine] = 0;
+    t->E[racine] = 0.0;
+    for (int v = 0; v < n; v++) {
+        int a = r->nb_arcs + v;
+        if (r->offre[v] > 0) {
+            t->origine[a] = v; t->destination[a] = racine;
+            t->flux[a] = r->offre[v];
+            t->E[v] = M;
+        } else {
+            t->origine[a] = racine; t->destination[a] = v;
+            t->flux[a] = -r->offre[v];
+            t->E[v] = -M;
+        }
+        t->cout[a] = M;
+        t->capacite[a] = INT_MAX;
+        t->etat[a] = ARC_BASE;
+        t->profondeur[v] = 1;
+        attacherNoeud(t, v, racine, a);
+    }
+    return true;
+}
+
+// ==========================================================
+// 3. PIVOTS
+// ==========================================================
+
+/**
+ * @brief Recherche par blocs : parcours circulaire depuis *suivant, arrêt à la fin du premier bloc
+ * contenant un candidat (meilleur coût marginal du bloc). Renvoie -1 si aucun arc n'améliore.
+ */
+static int choisirArcEntrant(const ArbreReseau* t, int taille_bloc, int* suivant) {
+    double meilleur = -EPSILON;
+    int entrant = -1, dans_bloc = 0;
+    int a = *suivant;
+    for (int k = 0; k < t->nb_arcs; k++) {
+        double delta = t->cout[a] - (t->E[t->origine[a]] - t->E[t->destination[a]]);
+        if (t->etat[a] * delta < meilleur) { meilleur = t->etat[a] * delta; entrant = a; }
+        if (++a == t->nb_arcs) a = 0;
+        if (++dans_bloc == taille_bloc) {
+            if (entrant >= 0) break;
+            dans_bloc = 0;
+        }
+    }
+    *suivant = a;
+    return entrant;
+}
+
+/**
+ * @brief Marge de l'arc qui relie x à son parent quand le flux du cycle va de x vers le parent
+ * (vers_parent) ou du parent vers x.
+ */
+static int margeArcParent(const ArbreReseau* t, int x, bool vers_parent) {
+    int a = t->arc_parent[x];
+    bool direct = (t->origine[a] == x) == vers_parent;
+    if (!direct) return t->flux[a];
+    return (t->capacite[a] == INT_MAX) ? INT_MAX : t->capacite[a] - t->flux[a];
+}
+
+static void pousserArcParent(ArbreReseau* t, int x, bool vers_parent, int theta) {
+    int a = t->arc_parent[x];
+    if ((t->origine[a] == x) == vers_parent) t->flux[a] += theta;
+    else t->flux[a] -= theta;
+}
+
+/**
+ * @brief Raccroche le sous-arbre détaché (qui contient q, coupé au-dessus de w) sous l'autre extrémité
+ * de l'arc entrant : les parents du chemin q -> w sont inversés, puis profondeurs et potentiels du
+ * sous-arbre sont recalculés (décalage constant des potentiels).
+ */
+static void raccrocherSousArbre(ArbreReseau* t, int q, int w, int autre, int entrant) {
+    int precedent = autre, arc = entrant, x = q;
+    for (;;) {
+        int suivant = t->parent[x], ancien_arc = t->arc_parent[x];
+        detacherNoeud(t, x);
+        attacherNoeud(t, x, precedent, arc);
+        if (x == w) break;
+        precedent = x; arc = ancien_arc; x = suivant;
+    }
+
+    int a = t->arc_parent[q], p = t->parent[q];
+    double E_q = (t->origine[a] == q) ? t->E[p] + t->cout[a] : t->E[p] - t->cout[a];
+    double decalage = E_q - t->E[q];
+    int sommet = 0;
+    t->pile[sommet++] = q;
+    while (sommet > 0) {
+        int y = t->pile[--sommet];
+        t->E[y] += decalage;
+        t->profondeur[y] = t->profondeur[t->parent[y]] + 1;
+        for (int f = t->premier_fils[y]; f >= 0; f = t->frere_suivant[f]) t->pile[sommet++] = f;
+    }
+}
+
+/**
+ * @brief Pivot sur l'arc entrant. Le flux circule de s vers c sur l'arc entrant, puis de c jusqu'au
+ * sommet du cycle et du sommet jusqu'à s. Arc sortant : dernier arc bloquant dans ce sens de parcours
+ * depuis le sommet (ordre : côté s, arc entrant, côté c).
+ * @return theta, ou -1 si le cycle n'est pas borné.
+ */
+static int pivoterReseau(ArbreReseau* t, int entrant) {
+    bool augmente = (t->etat[entrant] == ARC_INF);
+    int s = augmente ? t->origine[entrant] : t->destination[entrant];
+    int c = augmente ? t->destination[entrant] : t->origine[entrant];
+
+    int sommet_cycle = s, y = c;
+    while (sommet_cycle != y) {
+        if (t->profondeur[sommet_cycle] >= t->profondeur[y]) sommet_cycle = t->parent[sommet_cycle];
+        else y = t->parent[y];
+    }
+
+    // Côté s (parcouru du sommet vers s) : le premier minimum en remontant est le dernier dans le cycle
+    int theta = INT_MAX, w_sortant = -1;
+    bool cote_s = false;
+    for (int x = s; x != sommet_cycle; x = t->parent[x]) {
+        int marge = margeArcParent(t, x, false);
+        if (marge < theta) { theta = marge; w_sortant = x; cote_s = true; }
+    }
+    int marge_entrant = augmente
+        ? ((t->capacite[entrant] == INT_MAX) ? INT_MAX : t->capacite[entrant] - t->flux[entrant])
+        : t->flux[entrant];
+    if (marge_entrant <= theta) { theta = marge_entrant; w_sortant = -1; }
+    for (int x = c; x != sommet_cycle; x = t->parent[x]) {
+        int marge = margeArcParent(t, x, true);
+        if (marge <= theta) { theta = marge; w_sortant = x; cote_s = false; }
+    }
+    if (theta == INT_MAX) return -1;
+
+    if (theta > 0) {
+        t->flux[entrant] += augmente ? theta : -theta;
+        for (int x = s; x != sommet_cycle; x = t->parent[x]) pousserArcParent(t, x, false, theta);
+        for (int x = c; x != sommet_cycle; x = t->parent[x]) pousserArcParent(t, x, true, theta);
+    }
+
+    if (w_sortant < 0) {
+        // L'arc entrant est limitant : il change de borne, l'arbre est inchangé
+        t->etat[entrant] = -t->etat[entrant];
+        return theta;
+    }
+    int sortant = t->arc_parent[w_sortant];
+    t->etat[sortant] = (t->flux[sortant] == 0) ? ARC_INF : ARC_SUP;
+    t->etat[entrant] = ARC_BASE;
+    if (cote_s) raccrocherSousArbre(t, s, w_sortant, c, entrant);
+    else raccrocherSousArbre(t, c, w_sortant, s, entrant);
+    return theta;
+}
+
+// ==========================================================
+// 4. RESOLUTION
+// ==========================================================
+
+bool resoudreTransbordement(ReseauTransbordement* r, const OptionsMarchePied* o) {
+    OptionsMarchePied defaut;
+    if (!o) { optionsMarchePiedParDefaut(&defaut); o = &defaut; }
+
+    long equilibre = 0;
+    for (int v = 0; v < r->nb_noeuds; v++) equilibre += r->offre[v];
+    if (equilibre != 0) return false;
+
+    ArbreReseau t = { 0 };
+    if (!construireArbreInitial(&t, r)) { libererArbreReseau(&t); return false; }
+
+    int taille_bloc = (int)sqrt((double)t.nb_arcs);
+    if (taille_bloc < 10) taille_bloc = 10;
+    int suivant = 0;
+    int iter = 0, pivots = 0, pas_degeneres = 0;
+    bool optimal = false, borne = true;
+    CauseArret cause = ARRET_ITERATIONS;
+    double echeance = (o->delai_max > 0.0) ? horlogeMurale() + o->delai_max : 0.0;
+
+    while (iter < o->max_iterations) {
+        if (o->annulation && atomic_load_explicit(o->annulation, memory_order_relaxed)) { cause = ARRET_ANNULATION; break; }
+        if (echeance > 0.0 && horlogeMurale() >= echeance) { cause = ARRET_DELAI; break; }
+        iter++;
+
+        int entrant = choisirArcEntrant(&t, taille_bloc, &suivant);
+        if (entrant < 0) { optimal = true; cause = ARRET_OPTIMAL; break; }
+
+        int theta = pivoterReseau(&t, entrant);
+        if (theta < 0) { borne = false; break; }
+        pivots++;
+        if (theta == 0) pas_degeneres++;
+    }
+
+    // Flux artificiel résiduel : offre non acheminée (irréalisable si l'optimum est atteint)
+    bool admissible = borne;
+    for (int v = 0; v < r->nb_noeuds; v++) if (t.flux[r->nb_arcs + v] > 0) admissible = false;
+    memcpy(r->flux, t.flux, r->nb_arcs * sizeof(int));
+    if (optimal) for (int v = 0; v < r->nb_noeuds; v++) r->potentiel[v] = t.E[v] - t.E[0];
+
+    if (o->resultat) {
+        o->resultat->pivots = pivots;
+        o->resultat->pas_degeneres = pas_degeneres;
+        o->resultat->optimal = optimal && admissible;
+        o->resultat->cause = (optimal && !admissible) ? ARRET_IRREALISABLE : cause;
+        o->resultat->cout_initial = 0.0; // Base initiale : tout passe par les arcs artificiels
+        o->resultat->cout_total = coutReseau(r);
+        o->resultat->ecart_max = (optimal && admissible) ? 0.0 : DBL_MAX;
+    }
+    libererArbreReseau(&t);
+    return admissible;
+}